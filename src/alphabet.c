@@ -0,0 +1,253 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "alphabet.h"
+
+#include <stdlib.h>  /* for malloc */
+#include <string.h>  /* for memset, strchr, strlen */
+#include <math.h>    /* for floor, fmod, log */
+
+/** Largest number of a word, 2^53, beyond which doubles skip integers
+ *
+ * @since 1.2
+ */
+#define WORD_MAX_NUMBER  9007199254740992.0
+
+/** Expand an alphabet given like with tr(1), e.g. "a-z0-9"
+ *
+ * A dash between two characters stands for all characters in between,
+ * other characters stand for themselves.  Characters keep the order
+ * given, e.g. "ACGT" orders "C" before "G".
+ *
+ * @param[in] spec
+ * @param[out] dest Expanded alphabet, to be freed by the caller
+ *
+ * @return status
+ *
+ * @since 1.2
+ */
+alphabet_status expand_alphabet(const char * spec, char ** dest) {
+	unsigned char seen[256];
+	size_t length = 0;
+	const unsigned char * walker;
+
+	*dest = (char *)malloc(256 + 1);
+	if (! *dest) {
+		return ALPHABET_OUT_OF_MEMORY;
+	}
+	memset(seen, 0, sizeof(seen));
+
+	for (walker = (const unsigned char *)spec; *walker != '\0'; walker++) {
+		unsigned int first = walker[0];
+		unsigned int last = walker[0];
+		unsigned int c;
+
+		if ((walker[1] == '-') && (walker[2] != '\0')) {
+			if (walker[0] > walker[2]) {
+				free(*dest);
+				*dest = NULL;
+				return ALPHABET_INVERTED;
+			}
+			last = walker[2];
+			walker += 2;
+		}
+
+		for (c = first; c <= last; c++) {
+			if ((c == '.') || (c == ',')) {
+				free(*dest);
+				*dest = NULL;
+				return ALPHABET_RESERVED;
+			}
+			if (seen[c]) {
+				free(*dest);
+				*dest = NULL;
+				return ALPHABET_DUPLICATE;
+			}
+			seen[c] = 1;
+			(*dest)[length++] = (char)c;
+		}
+	}
+	(*dest)[length] = '\0';
+
+	if (length < 2) {
+		free(*dest);
+		*dest = NULL;
+		return ALPHABET_TOO_SMALL;
+	}
+	return ALPHABET_SUCCESS;
+}
+
+/** Find the number of a word over an alphabet
+ *
+ * @param[in] alphabet
+ * @param[in] word
+ * @param[out] dest
+ *
+ * @return WORD_SUCCESS if word is made of characters of alphabet only
+ *         and its number is exact in a double
+ *
+ * @since 1.2
+ */
+word_status word_to_number(const char * alphabet, const char * word, double * dest) {
+	const double size = (double)strlen(alphabet);
+	double number = 0;
+	int too_large = 0;
+
+	if (*word == '\0') {
+		return WORD_INVALID;
+	}
+
+	for (; *word != '\0'; word++) {
+		const char * const digit = strchr(alphabet, *word);
+		if (! digit) {
+			return WORD_INVALID;
+		}
+		/* Invalid characters take precedence over a number too large */
+		if (! too_large) {
+			number = number * size + (double)(digit - alphabet) + 1;
+			too_large = (number > WORD_MAX_NUMBER);
+		}
+	}
+
+	if (too_large) {
+		return WORD_TOO_LARGE;
+	}
+	*dest = number;
+	return WORD_SUCCESS;
+}
+
+/** Prepare rendering words over an alphabet
+ *
+ * @param[out] counter
+ * @param[in] alphabet At least two characters, kept by reference
+ *
+ * @return zero if out of memory, non-zero otherwise
+ *
+ * @since 1.2
+ */
+int word_counter_init(word_counter * counter, const char * alphabet) {
+	size_t i;
+
+	counter->alphabet = alphabet;
+	counter->size = strlen(alphabet);
+	memset(counter->digits, 0, sizeof(counter->digits));
+	for (i = 0; i < counter->size; i++) {
+		counter->digits[(unsigned char)alphabet[i]] = (unsigned char)i;
+	}
+
+	/* Enough characters for any double */
+	counter->capacity = (size_t)(1024 * log(2.0) / log((double)counter->size)) + 2;
+	counter->buffer = (char *)malloc(counter->capacity);
+	counter->start = counter->capacity;
+	counter->value = 0;
+	counter->started = 0;
+	return counter->buffer != NULL;
+}
+
+/** Render the word of given number into counter's buffer
+ *
+ * Neighbors of the previous word are derived from it in place, carrying
+ * or borrowing like an odometer; other numbers are converted anew.
+ * Values are rounded to whole numbers first, numbers below one make an
+ * empty word.
+ *
+ * @param[in,out] counter
+ * @param[in] value
+ *
+ * @since 1.2
+ */
+void word_counter_render(word_counter * counter, double value) {
+	const char first = counter->alphabet[0];
+	const char last = counter->alphabet[counter->size - 1];
+	double number = floor(value + 0.5);
+	size_t i;
+
+	if (counter->started && (counter->value >= 1) && (number == counter->value + 1)) {
+		/* "az" becomes "ba", "zz" becomes "aaa" */
+		for (i = counter->capacity; i > counter->start; i--) {
+			char * const c = counter->buffer + i - 1;
+			if (*c != last) {
+				*c = counter->alphabet[counter->digits[(unsigned char)*c] + 1];
+				break;
+			}
+			*c = first;
+		}
+		if (i == counter->start) {
+			counter->buffer[--counter->start] = first;
+		}
+	} else if (counter->started && (number >= 1) && (number == counter->value - 1)) {
+		/* "ba" becomes "az", "aaa" becomes "zz" */
+		for (i = counter->capacity; i > counter->start; i--) {
+			char * const c = counter->buffer + i - 1;
+			if (*c != first) {
+				*c = counter->alphabet[counter->digits[(unsigned char)*c] - 1];
+				break;
+			}
+			if (i - 1 == counter->start) {
+				counter->start++;
+				break;
+			}
+			*c = last;
+		}
+	} else if (! counter->started || (number != counter->value)) {
+		const double size = (double)counter->size;
+		double rest = number;
+
+		counter->start = counter->capacity;
+		while ((rest >= 1) && (counter->start > 0)) {
+			rest -= 1;
+			counter->buffer[--counter->start] = counter->alphabet[(size_t)fmod(rest, size)];
+			rest = floor(rest / size);
+		}
+	}
+
+	counter->value = number;
+	counter->started = 1;
+}
+
+/** Free memory held by a word counter
+ *
+ * @param[in,out] counter
+ *
+ * @since 1.2
+ */
+void word_counter_free(word_counter * counter) {
+	free(counter->buffer);
+	counter->buffer = NULL;
+}
@@ -0,0 +1,114 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ALPHABET_H
+#define ALPHABET_H 1
+
+#include <stddef.h>  /* for size_t */
+
+/** Characters of --random-string=LENGTH without --alphabet=CHARS
+ *
+ * @since 1.2
+ */
+#define DEFAULT_STRING_ALPHABET  "0-9A-Za-z"
+
+/** Enumeration of possible return values of expand_alphabet()
+ *
+ * @since 1.2
+ */
+typedef enum _alphabet_status {
+	ALPHABET_SUCCESS,
+	ALPHABET_TOO_SMALL,      /**< fewer than two characters */
+	ALPHABET_DUPLICATE,      /**< a character given twice */
+	ALPHABET_RESERVED,       /**< a character taken by range syntax */
+	ALPHABET_INVERTED,       /**< a range of characters descending, e.g. "z-a" */
+	ALPHABET_OUT_OF_MEMORY
+} alphabet_status;
+
+/** Enumeration of possible return values of word_to_number()
+ *
+ * @since 1.2
+ */
+typedef enum _word_status {
+	WORD_SUCCESS,
+	WORD_INVALID,            /**< empty or a character not in alphabet */
+	WORD_TOO_LARGE           /**< number beyond 2^53 */
+} word_status;
+
+/** State of rendering words over an alphabet, one after another
+ *
+ * Words are numbered in bijective base, like spreadsheet columns: with
+ * alphabet "a-z", "a" is 1, "z" is 26, "aa" is 27 and "zz" is 702.
+ * The word is kept right-aligned in a buffer so that a step of one in
+ * either direction only touches the trailing characters in place, like
+ * an odometer.
+ *
+ * @since 1.2
+ */
+typedef struct _word_counter {
+	const char * alphabet;       /**< characters in ascending order */
+	size_t size;                 /**< number of characters in alphabet */
+	unsigned char digits[256];   /**< position of each character in alphabet */
+	char * buffer;               /**< storage of word, right-aligned */
+	size_t capacity;             /**< number of bytes in buffer */
+	size_t start;                /**< offset of first character of word */
+	double value;                /**< number of current word */
+	int started;                 /**< non-zero once a word was rendered */
+} word_counter;
+
+alphabet_status expand_alphabet(const char * spec, char ** dest);
+word_status word_to_number(const char * alphabet, const char * word, double * dest);
+
+int word_counter_init(word_counter * counter, const char * alphabet);
+void word_counter_render(word_counter * counter, double value);
+void word_counter_free(word_counter * counter);
+
+/** Start of the word rendered last
+ *
+ * @since 1.2
+ */
+#define WORD_TEXT(counter)  ((counter)->buffer + (counter)->start)
+
+/** Length of the word rendered last
+ *
+ * @since 1.2
+ */
+#define WORD_LENGTH(counter)  ((counter)->capacity - (counter)->start)
+
+#endif /* ALPHABET_H */
@@ -0,0 +1,314 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "blake3.h"
+#include "assertion.h"
+
+#include <limits.h>  /* for CHAR_BIT */
+#include <string.h>  /* for memcpy */
+
+/** @name BLAKE3 domain separation flags
+ *
+ * @since 1.2
+ */
+/*@{*/
+#define CHUNK_START  (1 << 0)
+#define CHUNK_END  (1 << 1)
+#define PARENT  (1 << 2)
+#define ROOT  (1 << 3)
+/*@}*/
+
+/** Rotate a 32 bit word to the right
+ *
+ * @since 1.2
+ */
+#define ROTATE_RIGHT(x, n)  ((((x) >> (n)) | ((x) << (32 - (n)))) & 0xffffffffU)
+
+/** BLAKE3 mixing function on words a, b, c and d of s
+ *
+ * @since 1.2
+ */
+#define G(s, a, b, c, d, mx, my) \
+	s[a] = (s[a] + s[b] + (mx)) & 0xffffffffU; s[d] = ROTATE_RIGHT(s[d] ^ s[a], 16); \
+	s[c] = (s[c] + s[d]) & 0xffffffffU; s[b] = ROTATE_RIGHT(s[b] ^ s[c], 12); \
+	s[a] = (s[a] + s[b] + (my)) & 0xffffffffU; s[d] = ROTATE_RIGHT(s[d] ^ s[a], 8); \
+	s[c] = (s[c] + s[d]) & 0xffffffffU; s[b] = ROTATE_RIGHT(s[b] ^ s[c], 7);
+
+/** Initialization vector, shared with SHA-256 */
+static const unsigned int iv[8] = {
+	0x6a09e667U, 0xbb67ae85U, 0x3c6ef372U, 0xa54ff53aU,
+	0x510e527fU, 0x9b05688cU, 0x1f83d9abU, 0x5be0cd19U
+};
+
+/** Order of message words for the next round */
+static const unsigned int permutation[16] = {
+	2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8
+};
+
+/** Input to a compression whose output is not known to be needed yet
+ *
+ * The last block of a chunk (or of a parent node) is compressed only
+ * once it is known whether it is the root of the tree.
+ *
+ * @since 1.2
+ */
+typedef struct _blake3_output {
+	unsigned int chaining[8];  /**< input chaining value */
+	unsigned int words[16];    /**< block as words */
+	unsigned long counter;     /**< chunk counter */
+	unsigned int block_len;    /**< number of bytes in block */
+	unsigned int flags;        /**< domain separation flags */
+} blake3_output;
+
+/** Read a little endian 32 bit word
+ *
+ * @param[in] bytes
+ *
+ * @return Word
+ *
+ * @since 1.2
+ */
+static unsigned int load_le32(const unsigned char * bytes) {
+	return (unsigned int)bytes[0]
+		| ((unsigned int)bytes[1] << 8)
+		| ((unsigned int)bytes[2] << 16)
+		| ((unsigned int)bytes[3] << 24);
+}
+
+/** BLAKE3 compression function.
+ *
+ * @param[in] output Chaining value, block, counter, length and flags
+ * @param[out] dest 16 words of output state
+ *
+ * @since 1.2
+ */
+static void compress(blake3_output const * output, unsigned int * dest) {
+	unsigned int m[16];
+	unsigned int t[16];
+	unsigned int i;
+	unsigned int round;
+
+	for (i = 0; i < 8; i++) {
+		dest[i] = output->chaining[i];
+	}
+	for (i = 0; i < 4; i++) {
+		dest[8 + i] = iv[i];
+	}
+	dest[12] = output->counter & 0xffffffffUL;
+	dest[13] = (output->counter >> 16 >> 16) & 0xffffffffUL;
+	dest[14] = output->block_len;
+	dest[15] = output->flags;
+
+	memcpy(m, output->words, sizeof(m));
+	for (round = 0; round < 7; round++) {
+		/* Column step */
+		G(dest, 0, 4,  8, 12, m[0], m[1])
+		G(dest, 1, 5,  9, 13, m[2], m[3])
+		G(dest, 2, 6, 10, 14, m[4], m[5])
+		G(dest, 3, 7, 11, 15, m[6], m[7])
+		/* Diagonal step */
+		G(dest, 0, 5, 10, 15, m[8], m[9])
+		G(dest, 1, 6, 11, 12, m[10], m[11])
+		G(dest, 2, 7,  8, 13, m[12], m[13])
+		G(dest, 3, 4,  9, 14, m[14], m[15])
+
+		for (i = 0; i < 16; i++) {
+			t[i] = m[permutation[i]];
+		}
+		memcpy(m, t, sizeof(m));
+	}
+
+	for (i = 0; i < 8; i++) {
+		dest[i] ^= dest[8 + i];
+		dest[8 + i] ^= output->chaining[i];
+	}
+}
+
+/** Prepare compression of the block buffered in context.
+ *
+ * @param[in] context
+ * @param[out] output
+ * @param[in] flags Flags in addition to chunk start
+ *
+ * @since 1.2
+ */
+static void prepare_chunk_output(blake3_context const * context,
+		blake3_output * output, unsigned int flags) {
+	unsigned int i;
+
+	memcpy(output->chaining, context->chaining, sizeof(output->chaining));
+	for (i = 0; i < 16; i++) {
+		output->words[i] = load_le32(context->block + 4 * i);
+	}
+	output->counter = context->chunk_counter;
+	output->block_len = context->block_len;
+	output->flags = flags | ((context->blocks_compressed == 0) ? CHUNK_START : 0);
+}
+
+/** Prepare compression of a parent node.
+ *
+ * @param[out] output
+ * @param[in] left Chaining value of left child
+ * @param[in] right Chaining value of right child
+ *
+ * @since 1.2
+ */
+static void prepare_parent_output(blake3_output * output,
+		const unsigned int * left, const unsigned int * right) {
+	memcpy(output->chaining, iv, sizeof(output->chaining));
+	memcpy(output->words, left, 8 * sizeof(unsigned int));
+	memcpy(output->words + 8, right, 8 * sizeof(unsigned int));
+	output->counter = 0;
+	output->block_len = BLAKE3_BLOCK_LEN;
+	output->flags = PARENT;
+}
+
+/** Start a new BLAKE3 hash.
+ *
+ * @param[out] context
+ *
+ * @since 1.2
+ */
+void blake3_init(blake3_context * context) {
+	assert(sizeof(unsigned int) * CHAR_BIT == 32);
+
+	memcpy(context->chaining, iv, sizeof(context->chaining));
+	context->block_len = 0;
+	context->blocks_compressed = 0;
+	context->chunk_counter = 0;
+	context->stack_len = 0;
+}
+
+/** Feed data into a BLAKE3 hash.
+ *
+ * Whenever a chunk is complete, its chaining value is merged with those
+ * of completed subtrees of the same size, so the stack holds one
+ * chaining value per bit set in the number of chunks.
+ *
+ * @param[in,out] context
+ * @param[in] data
+ * @param[in] length Number of bytes
+ *
+ * @since 1.2
+ */
+void blake3_update(blake3_context * context, const unsigned char * data,
+		size_t length) {
+	while (length > 0) {
+		size_t take;
+
+		if (context->block_len == BLAKE3_BLOCK_LEN) {
+			blake3_output output;
+			unsigned int state[16];
+
+			if (context->blocks_compressed == BLAKE3_CHUNK_LEN / BLAKE3_BLOCK_LEN - 1) {
+				/* Chunk complete and more input pending */
+				unsigned long chunks;
+				unsigned int cv[8];
+
+				prepare_chunk_output(context, &output, CHUNK_END);
+				compress(&output, state);
+				memcpy(cv, state, sizeof(cv));
+
+				for (chunks = context->chunk_counter + 1; (chunks & 1) == 0; chunks >>= 1) {
+					assert(context->stack_len > 0);
+					context->stack_len--;
+					prepare_parent_output(&output, context->stack[context->stack_len], cv);
+					compress(&output, state);
+					memcpy(cv, state, sizeof(cv));
+				}
+				assert(context->stack_len < BLAKE3_MAX_DEPTH);
+				memcpy(context->stack[context->stack_len], cv, sizeof(cv));
+				context->stack_len++;
+
+				memcpy(context->chaining, iv, sizeof(context->chaining));
+				context->chunk_counter++;
+				context->blocks_compressed = 0;
+			} else {
+				prepare_chunk_output(context, &output, 0);
+				compress(&output, state);
+				memcpy(context->chaining, state, sizeof(context->chaining));
+				context->blocks_compressed++;
+			}
+			context->block_len = 0;
+		}
+
+		take = BLAKE3_BLOCK_LEN - context->block_len;
+		if (take > length) {
+			take = length;
+		}
+		memcpy(context->block + context->block_len, data, take);
+		context->block_len += take;
+		data += take;
+		length -= take;
+	}
+}
+
+/** Finish a BLAKE3 hash.
+ *
+ * The context is left untouched, so hashing may continue.
+ *
+ * @param[in] context
+ * @param[out] digest Room for BLAKE3_OUT_LEN bytes
+ *
+ * @since 1.2
+ */
+void blake3_final(blake3_context const * context, unsigned char * digest) {
+	blake3_output output;
+	unsigned int state[16];
+	unsigned int i;
+
+	/* Zero padding of the last block */
+	blake3_context last = *context;
+	memset(last.block + last.block_len, 0, BLAKE3_BLOCK_LEN - last.block_len);
+
+	prepare_chunk_output(&last, &output, CHUNK_END);
+	for (i = context->stack_len; i > 0; i--) {
+		unsigned int cv[8];
+
+		compress(&output, state);
+		memcpy(cv, state, sizeof(cv));
+		prepare_parent_output(&output, context->stack[i - 1], cv);
+	}
+
+	output.flags |= ROOT;
+	compress(&output, state);
+	for (i = 0; i < BLAKE3_OUT_LEN; i++) {
+		digest[i] = (state[i / 4] >> (8 * (i % 4))) & 0xff;
+	}
+}
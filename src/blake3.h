@@ -0,0 +1,75 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BLAKE3_H
+#define BLAKE3_H 1
+
+#include <sys/types.h>  /* for size_t */
+
+/** @name BLAKE3 dimensions
+ *
+ * @since 1.2
+ */
+/*@{*/
+#define BLAKE3_OUT_LEN  32
+#define BLAKE3_BLOCK_LEN  64
+#define BLAKE3_CHUNK_LEN  1024
+#define BLAKE3_MAX_DEPTH  54
+/*@}*/
+
+/** State of an incremental BLAKE3 hash in default mode
+ *
+ * @since 1.2
+ */
+typedef struct _blake3_context {
+	unsigned int chaining[8];              /**< chaining value of current chunk */
+	unsigned char block[BLAKE3_BLOCK_LEN]; /**< bytes of current block */
+	unsigned int block_len;                /**< number of bytes in block */
+	unsigned int blocks_compressed;        /**< blocks of current chunk done */
+	unsigned long chunk_counter;           /**< number of current chunk */
+	unsigned int stack[BLAKE3_MAX_DEPTH][8]; /**< chaining values of subtrees */
+	unsigned int stack_len;                /**< number of subtrees on stack */
+} blake3_context;
+
+void blake3_init(blake3_context * context);
+void blake3_update(blake3_context * context, const unsigned char * data,
+		size_t length);
+void blake3_final(blake3_context const * context, unsigned char * digest);
+
+#endif /* BLAKE3_H */
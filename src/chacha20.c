@@ -0,0 +1,162 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "chacha20.h"
+#include "assertion.h"
+
+#include <limits.h>  /* for CHAR_BIT */
+
+/** Rotate a 32 bit word to the left
+ *
+ * @since 1.2
+ */
+#define ROTATE_LEFT(x, n)  ((((x) << (n)) | ((x) >> (32 - (n)))) & 0xffffffffU)
+
+/** ChaCha quarter round on words a, b, c and d of x
+ *
+ * @since 1.2
+ */
+#define QUARTER_ROUND(x, a, b, c, d) \
+	x[a] = (x[a] + x[b]) & 0xffffffffU; x[d] = ROTATE_LEFT(x[d] ^ x[a], 16); \
+	x[c] = (x[c] + x[d]) & 0xffffffffU; x[b] = ROTATE_LEFT(x[b] ^ x[c], 12); \
+	x[a] = (x[a] + x[b]) & 0xffffffffU; x[d] = ROTATE_LEFT(x[d] ^ x[a], 8); \
+	x[c] = (x[c] + x[d]) & 0xffffffffU; x[b] = ROTATE_LEFT(x[b] ^ x[c], 7);
+
+/** Read a little endian 32 bit word
+ *
+ * @param[in] bytes
+ *
+ * @return Word
+ *
+ * @since 1.2
+ */
+static unsigned int load_le32(const unsigned char * bytes) {
+	return (unsigned int)bytes[0]
+		| ((unsigned int)bytes[1] << 8)
+		| ((unsigned int)bytes[2] << 16)
+		| ((unsigned int)bytes[3] << 24);
+}
+
+/** Set up a ChaCha20 keystream.
+ *
+ * @param[out] context
+ * @param[in] key 32 bytes of key
+ * @param[in] nonce 12 bytes of nonce
+ * @param[in] counter Number of first block to produce
+ *
+ * @since 1.2
+ */
+void chacha20_init(chacha20_context * context, const unsigned char * key,
+		const unsigned char * nonce, unsigned int counter) {
+	unsigned int i;
+
+	assert(sizeof(unsigned int) * CHAR_BIT == 32);
+
+	for (i = 0; i < CHACHA20_KEY_WORDS; i++) {
+		context->key[i] = load_le32(key + 4 * i);
+	}
+	for (i = 0; i < CHACHA20_NONCE_WORDS; i++) {
+		context->nonce[i] = load_le32(nonce + 4 * i);
+	}
+	context->counter = counter;
+}
+
+/** Produce keystream blocks.
+ *
+ * Writes CHACHA20_BLOCK_WORDS words per block to dest, i.e. the
+ * keystream in host byte order.  Producing several blocks at once keeps
+ * the per-call overhead low.
+ *
+ * @param[in,out] context
+ * @param[out] dest Room for blocks * CHACHA20_BLOCK_WORDS words
+ * @param[in] blocks Number of blocks to produce
+ *
+ * @since 1.2
+ */
+void chacha20_keystream(chacha20_context * context, unsigned int * dest,
+		size_t blocks) {
+	unsigned int input[CHACHA20_BLOCK_WORDS];
+	size_t block;
+	unsigned int i;
+
+	/* "expand 32-byte k" */
+	input[0] = 0x61707865U;
+	input[1] = 0x3320646eU;
+	input[2] = 0x79622d32U;
+	input[3] = 0x6b206574U;
+	for (i = 0; i < CHACHA20_KEY_WORDS; i++) {
+		input[4 + i] = context->key[i];
+	}
+	for (i = 0; i < CHACHA20_NONCE_WORDS; i++) {
+		input[13 + i] = context->nonce[i];
+	}
+
+	for (block = 0; block < blocks; block++) {
+		unsigned int * const x = dest + block * CHACHA20_BLOCK_WORDS;
+
+		input[12] = context->counter;
+		for (i = 0; i < CHACHA20_BLOCK_WORDS; i++) {
+			x[i] = input[i];
+		}
+
+		for (i = 0; i < 10; i++) {
+			/* Column round */
+			QUARTER_ROUND(x, 0, 4,  8, 12)
+			QUARTER_ROUND(x, 1, 5,  9, 13)
+			QUARTER_ROUND(x, 2, 6, 10, 14)
+			QUARTER_ROUND(x, 3, 7, 11, 15)
+			/* Diagonal round */
+			QUARTER_ROUND(x, 0, 5, 10, 15)
+			QUARTER_ROUND(x, 1, 6, 11, 12)
+			QUARTER_ROUND(x, 2, 7,  8, 13)
+			QUARTER_ROUND(x, 3, 4,  9, 14)
+		}
+
+		for (i = 0; i < CHACHA20_BLOCK_WORDS; i++) {
+			x[i] = (x[i] + input[i]) & 0xffffffffU;
+		}
+
+		/* Continue with the next nonce rather than repeating keystream */
+		context->counter = (context->counter + 1) & 0xffffffffU;
+		if (context->counter == 0) {
+			context->nonce[0] = (context->nonce[0] + 1) & 0xffffffffU;
+			input[13] = context->nonce[0];
+		}
+	}
+}
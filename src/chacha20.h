@@ -0,0 +1,70 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CHACHA20_H
+#define CHACHA20_H 1
+
+#include <sys/types.h>  /* for size_t */
+
+/** @name ChaCha20 dimensions
+ *
+ * @since 1.2
+ */
+/*@{*/
+#define CHACHA20_KEY_WORDS  8
+#define CHACHA20_NONCE_WORDS  3
+#define CHACHA20_BLOCK_WORDS  16
+/*@}*/
+
+/** State of a ChaCha20 keystream (RFC 7539)
+ *
+ * @since 1.2
+ */
+typedef struct _chacha20_context {
+	unsigned int key[CHACHA20_KEY_WORDS];     /**< 256 bit key */
+	unsigned int nonce[CHACHA20_NONCE_WORDS]; /**< 96 bit nonce */
+	unsigned int counter;                     /**< number of next block */
+} chacha20_context;
+
+void chacha20_init(chacha20_context * context, const unsigned char * key,
+		const unsigned char * nonce, unsigned int counter);
+void chacha20_keystream(chacha20_context * context, unsigned int * dest,
+		size_t blocks);
+
+#endif /* CHACHA20_H */
@@ -0,0 +1,320 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "choice.h"
+#include "random.h"
+
+#include <stdlib.h>  /* for malloc */
+#include <string.h>  /* for memchr */
+#include <fcntl.h>   /* for open */
+#include <unistd.h>  /* for close */
+
+/** Read all of a file, mapping it into memory where possible
+ *
+ * @param[out] reader
+ * @param[in] filename
+ *
+ * @return status
+ *
+ * @since 1.2
+ */
+static choice_status read_whole_file(input_reader * reader, const char * filename) {
+	const int fd = open(filename, O_RDONLY);
+
+	if (fd == -1) {
+		return CHOICE_UNREADABLE;
+	}
+
+	if (! input_init(reader, fd, INPUT_BLOCK_SIZE)) {
+		close(fd);
+		return CHOICE_OUT_OF_MEMORY;
+	}
+
+	if (! input_map(reader)) {
+		while (! reader->eof) {
+			if ((reader->end == reader->capacity) && ! input_grow(reader)) {
+				input_free(reader);
+				close(fd);
+				return CHOICE_OUT_OF_MEMORY;
+			}
+			if (input_refill(reader) < 0) {
+				input_free(reader);
+				close(fd);
+				return CHOICE_UNREADABLE;
+			}
+		}
+	}
+
+	/* A mapping outlives its file descriptor */
+	close(fd);
+	return CHOICE_SUCCESS;
+}
+
+/** Load a file and index its lines
+ *
+ * @param[out] file
+ * @param[in] filename
+ *
+ * @return status
+ *
+ * @since 1.2
+ */
+choice_status line_file_load(line_file * file, const char * filename) {
+	const choice_status status = read_whole_file(&(file->reader), filename);
+	const char * const data = file->reader.data;
+	const size_t size = file->reader.end;
+	const char * walker;
+	size_t index = 0;
+
+	file->starts = NULL;
+	file->count = 0;
+	if (status != CHOICE_SUCCESS) {
+		return status;
+	}
+
+	/* Count lines first, a last line may lack its newline */
+	for (walker = data; walker < data + size; walker++) {
+		walker = (const char *)memchr(walker, '\n', data + size - walker);
+		if (! walker) {
+			file->count++;
+			break;
+		}
+		file->count++;
+	}
+
+	if (file->count == 0) {
+		input_free(&(file->reader));
+		return CHOICE_EMPTY;
+	}
+
+	file->starts = (size_t *)malloc((file->count + 1) * sizeof(size_t));
+	if (! file->starts) {
+		input_free(&(file->reader));
+		return CHOICE_OUT_OF_MEMORY;
+	}
+
+	file->starts[0] = 0;
+	for (walker = data; walker < data + size; walker++) {
+		walker = (const char *)memchr(walker, '\n', data + size - walker);
+		if (! walker) {
+			break;
+		}
+		file->starts[++index] = walker + 1 - data;
+	}
+	if (index < file->count) {
+		file->starts[file->count] = size + 1;
+	}
+	return CHOICE_SUCCESS;
+}
+
+/** Free memory held by a loaded file
+ *
+ * @param[in,out] file
+ *
+ * @since 1.2
+ */
+void line_file_free(line_file * file) {
+	free(file->starts);
+	file->starts = NULL;
+	input_free(&(file->reader));
+}
+
+/** Build an alias table from weights
+ *
+ * Indices with scaled weights below and above one are paired up so that
+ * each slot holds at most two indices, see Vose (1991).
+ *
+ * @param[out] table
+ * @param[in] weights Non-negative weights, not all zero
+ * @param[in] count Number of weights
+ *
+ * @return status
+ *
+ * @since 1.2
+ */
+choice_status alias_table_init(alias_table * table, const double * weights, size_t count) {
+	size_t * worklist;
+	size_t small_count = 0;
+	size_t large_start = count;
+	double sum = 0;
+	size_t i;
+
+	table->count = count;
+	table->probabilities = (double *)malloc(count * sizeof(double));
+	table->aliases = (size_t *)malloc(count * sizeof(size_t));
+	worklist = (size_t *)malloc(count * sizeof(size_t));
+	if (! table->probabilities || ! table->aliases || ! worklist) {
+		free(worklist);
+		alias_table_free(table);
+		return CHOICE_OUT_OF_MEMORY;
+	}
+
+	for (i = 0; i < count; i++) {
+		sum += weights[i];
+	}
+	if (! (sum > 0)) {
+		free(worklist);
+		alias_table_free(table);
+		return CHOICE_INVALID_WEIGHT;
+	}
+
+	/* Small indices grow from the front of the worklist, large ones from the back */
+	for (i = 0; i < count; i++) {
+		table->probabilities[i] = weights[i] * count / sum;
+		table->aliases[i] = i;
+		if (table->probabilities[i] < 1) {
+			worklist[small_count++] = i;
+		} else {
+			worklist[--large_start] = i;
+		}
+	}
+
+	while ((small_count > 0) && (large_start < count)) {
+		const size_t small = worklist[--small_count];
+		const size_t large = worklist[large_start++];
+
+		table->aliases[small] = large;
+		table->probabilities[large] -= 1 - table->probabilities[small];
+		if (table->probabilities[large] < 1) {
+			worklist[small_count++] = large;
+		} else {
+			worklist[--large_start] = large;
+		}
+	}
+
+	/* Left over by rounding errors only */
+	while (small_count > 0) {
+		table->probabilities[worklist[--small_count]] = 1;
+	}
+	while (large_start < count) {
+		table->probabilities[worklist[large_start++]] = 1;
+	}
+
+	free(worklist);
+	return CHOICE_SUCCESS;
+}
+
+/** Build an alias table from weights in a file
+ *
+ * Weights are separated like numbers read by input_next_number(),
+ * e.g. one per line.
+ *
+ * @param[out] table
+ * @param[in] filename
+ * @param[in] count Number of weights expected
+ *
+ * @return status
+ *
+ * @since 1.2
+ */
+choice_status alias_table_load(alias_table * table, const char * filename, size_t count) {
+	double * const weights = (double *)malloc(count * sizeof(double));
+	input_reader reader;
+	input_status input = INPUT_NUMBER;
+	choice_status status;
+	size_t found = 0;
+
+	table->probabilities = NULL;
+	table->aliases = NULL;
+	table->count = 0;
+	if (! weights) {
+		return CHOICE_OUT_OF_MEMORY;
+	}
+
+	status = read_whole_file(&reader, filename);
+	if (status != CHOICE_SUCCESS) {
+		free(weights);
+		return status;
+	}
+
+	while (status == CHOICE_SUCCESS) {
+		double weight;
+		unsigned int precision;
+
+		input = input_next_number(&reader, &weight, &precision);
+		if (input == INPUT_END) {
+			break;
+		} else if ((input != INPUT_NUMBER) || ! (weight >= 0)) {
+			status = CHOICE_INVALID_WEIGHT;
+		} else if (found == count) {
+			status = CHOICE_WEIGHT_COUNT;
+		} else {
+			weights[found++] = weight;
+		}
+	}
+	input_free(&reader);
+
+	if ((status == CHOICE_SUCCESS) && (found < count)) {
+		status = CHOICE_WEIGHT_COUNT;
+	}
+	if (status == CHOICE_SUCCESS) {
+		status = alias_table_init(table, weights, count);
+	}
+	free(weights);
+	return status;
+}
+
+/** Draw an index with probability proportional to its weight
+ *
+ * @param[in] table
+ *
+ * @return index from 0 to count - 1
+ *
+ * @since 1.2
+ */
+size_t alias_table_draw(alias_table const * table) {
+	const size_t index = (size_t)enum_random_index((double)table->count);
+
+	return (enum_random_uniform() < table->probabilities[index])
+		? index
+		: table->aliases[index];
+}
+
+/** Free memory held by an alias table
+ *
+ * @param[in,out] table
+ *
+ * @since 1.2
+ */
+void alias_table_free(alias_table * table) {
+	free(table->probabilities);
+	free(table->aliases);
+	table->probabilities = NULL;
+	table->aliases = NULL;
+}
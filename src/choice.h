@@ -0,0 +1,109 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CHOICE_H
+#define CHOICE_H 1
+
+#include "input.h"
+
+#include <stddef.h>  /* for size_t */
+
+/** Enumeration of possible return values of line_file_load() and
+ * alias_table_load()
+ *
+ * @since 1.2
+ */
+typedef enum _choice_status {
+	CHOICE_SUCCESS,
+	CHOICE_UNREADABLE,      /**< file could not be opened or read */
+	CHOICE_EMPTY,           /**< file has no lines */
+	CHOICE_INVALID_WEIGHT,  /**< weight negative or not a number, or all weights zero */
+	CHOICE_WEIGHT_COUNT,    /**< number of weights differs from number of lines */
+	CHOICE_OUT_OF_MEMORY
+} choice_status;
+
+/** Lines of a file, loaded once and indexed
+ *
+ * The file is mapped into memory where possible so that lines are
+ * never copied.  Line i starts at offset starts[i] and ends right
+ * before the newline at offset starts[i + 1] - 1; a last line without
+ * newline ends at the end of the file all the same.
+ *
+ * @since 1.2
+ */
+typedef struct _line_file {
+	input_reader reader;  /**< content of file, see data and end */
+	size_t * starts;      /**< offset of each line, count + 1 entries */
+	size_t count;         /**< number of lines */
+} line_file;
+
+/** Alias table for drawing indices with given weights in constant time
+ *
+ * Index i is kept with probability probabilities[i] and replaced by
+ * aliases[i] otherwise, following Vose (1991).
+ *
+ * @since 1.2
+ */
+typedef struct _alias_table {
+	double * probabilities;  /**< chance of keeping each index */
+	size_t * aliases;        /**< replacement of each index */
+	size_t count;            /**< number of indices */
+} alias_table;
+
+choice_status line_file_load(line_file * file, const char * filename);
+void line_file_free(line_file * file);
+
+choice_status alias_table_init(alias_table * table, const double * weights, size_t count);
+choice_status alias_table_load(alias_table * table, const char * filename, size_t count);
+size_t alias_table_draw(alias_table const * table);
+void alias_table_free(alias_table * table);
+
+/** Start of line at index
+ *
+ * @since 1.2
+ */
+#define LINE_TEXT(file, index)  ((file)->reader.data + (file)->starts[index])
+
+/** Length of line at index, without newline
+ *
+ * @since 1.2
+ */
+#define LINE_LENGTH(file, index)  ((file)->starts[(index) + 1] - (file)->starts[index] - 1)
+
+#endif /* CHOICE_H */
@@ -40,9 +40,13 @@
 #include "generator.h"
 #include "assertion.h"
 #include "utils.h"
-#include <stdlib.h>  /* for rand */
-#include <math.h>  /* for fabs, ceil, floor, fmod, log, pow, rand */
-#include <float.h>  /* for FLT_MAX */
+#include "random.h"
+#include <stdlib.h>  /* for rand, malloc */
+#include <stdio.h>  /* for sprintf */
+#include <string.h>  /* for strlen */
+#include <math.h>  /* for fabs, ceil, exp, floor, fmod, log, log10, pow, rand */
+#include <float.h>  /* for DBL_MAX, FLT_MAX */
+#include <limits.h>  /* for ULONG_MAX */
 
 /** Calculate precision of float.
  *
@@ -60,7 +64,8 @@ static unsigned int calc_precision(float element) {
 	unsigned int ptemp;
 	unsigned int i;
 
-	ptemp = (element - (int)element) * pow(10, MAX_POST_DOT_DIGITS);
+	/* fmod rather than a cast to int, which overflows for large elements */
+	ptemp = fmod(element, 1.0) * pow(10, MAX_POST_DOT_DIGITS);
 	if (ptemp != 0) {
 		precision = MAX_POST_DOT_DIGITS;
 		for (i = MAX_POST_DOT_DIGITS; i > 0; i--) {
@@ -105,6 +110,143 @@ static void ensure_proper_step_sign(scaffolding * scaffold) {
 	}
 }
 
+/** Correct direction of ratio if necessary.
+ *
+ * Ensure a ratio grows magnitude from left towards right, or shrinks it.
+ *
+ * @param[in,out] scaffold
+ *
+ * @since 1.2
+ */
+static void ensure_proper_ratio(scaffolding * scaffold) {
+	const int growing = fabs(scaffold->left) <= fabs(scaffold->right);
+	if (growing != (scaffold->step >= 1)) {
+		scaffold->step = 1 / scaffold->step;
+	}
+}
+
+/** Raise base to a power by squaring and multiplying.
+ *
+ * Unlike pow(), only multiplications are involved, so that powers doubles
+ * can hold, e.g. 2^30 or 10^15, are exact, and rounding errors grow with
+ * the number of bits of the exponent only, not with the exponent.
+ *
+ * @param[in] base
+ * @param[in] exponent
+ *
+ * @return base^exponent
+ *
+ * @since 1.2
+ */
+static double power_of(double base, unsigned long exponent) {
+	double result = 1;
+
+	while (exponent > 0) {
+		if (exponent & 1) {
+			result *= base;
+		}
+		base *= base;
+		exponent >>= 1;
+	}
+	return result;
+}
+
+/** Calculate the number of steps from left to a value.
+ *
+ * @param[in] scaffold
+ * @param[in] value
+ *
+ * @return number of steps, not rounded
+ *
+ * @since 1.2
+ */
+static double distance_in_steps(scaffolding const * scaffold, double value) {
+	if (CHECK_FLAG(scaffold->flags, FLAG_GEOMETRIC)) {
+		return fabs(log(value / scaffold->left) / log(scaffold->step));
+	}
+	return fabs(value - scaffold->left) / fabs(scaffold->step);
+}
+
+/** Calculate a candidate for output.
+ *
+ * Based on known values, calculate a possible candidate for enum_yield to
+ * place into scaffold or check if there will be another valid one.
+ *
+ * @param[in] scaffold
+ * @param[in] position Position of the candidate, counting from 0
+ *
+ * @return A calculated candidate for enum_yield to place into scaffold
+ *
+ * @since 0.5
+ */
+static double calc_candidate(scaffolding const * scaffold, unsigned long position) {
+	if (CHECK_FLAG(scaffold->flags, FLAG_GEOMETRIC)) {
+		/* Logarithmically spaced values are anchored at both ends */
+		if (! CHECK_FLAG(scaffold->flags, FLAG_USER_STEP)
+				&& HAS_RIGHT(scaffold) && HAS_COUNT(scaffold)
+				&& (2 * position >= scaffold->count - 1)) {
+			return scaffold->right / power_of(scaffold->step, scaffold->count - 1 - position);
+		}
+		return scaffold->left * power_of(scaffold->step, position);
+	} else if (! CHECK_FLAG(scaffold->flags, FLAG_USER_STEP)
+			&& HAS_RIGHT(scaffold) && HAS_COUNT(scaffold)) {
+		return  scaffold->left + (scaffold->right - scaffold->left)
+			/ (scaffold->count - 1) * position;
+	} else {
+		return scaffold->left + scaffold->step * position;
+	}
+}
+
+/** Checks a candidate for validity.
+ *
+ * @param[in] scaffold Settings to apply
+ *
+ * @return Validity bool (1 means valid, 0 mean invalid)
+ *
+ * @since 0.5
+ */
+static int check_candidate(scaffolding const * scaffold, double candidate) {
+	if (HAS_RIGHT(scaffold)
+			&& (((scaffold->left <= scaffold->right) && ((candidate - scaffold->right) > FLOAT_EQUAL_DELTA))
+				|| ((scaffold->left >= scaffold->right) && (scaffold->right - candidate) > FLOAT_EQUAL_DELTA))) {
+		return 0;
+	}
+	return 1;
+}
+
+/** Narrow the window of a completed scaffold down to a single shard.
+ *
+ * The window selected by skip and limit is split into shard_count
+ * contiguous slices of balanced size, the larger slices coming last.
+ * Skip and limit are then adjusted to cover slice shard_index (counting
+ * from 1) only.
+ *
+ * @param[in,out] scaffold
+ *
+ * @since 1.2
+ */
+static void select_shard(scaffolding * scaffold) {
+	unsigned long window;
+	unsigned long offset;
+	unsigned long size;
+
+	assert((scaffold->shard_index >= 1)
+		&& (scaffold->shard_index <= scaffold->shard_count));
+
+	if (! count_window(scaffold, &window)) {
+		/* Infinity without limit is rejected by the caller */
+		return;
+	}
+
+	split_evenly(window, scaffold->shard_count, scaffold->shard_index - 1,
+		&offset, &size);
+
+	scaffold->skip += offset;
+	scaffold->limit = size;
+	scaffold->flags |= FLAG_LIMIT_SET;
+	scaffold->position = scaffold->skip;
+}
+
 /** Calculate values in scaffold not given by user input.
  *
  * Main function to produce a usable scaffold for output calculation. All
@@ -118,6 +260,14 @@ static void ensure_proper_step_sign(scaffolding * scaffold) {
 void complete_scaffold(scaffolding * scaffold) {
 	assert(KNOWN(scaffold) >= 1);
 
+	/* Jump to the start of the window right away */
+	scaffold->position = scaffold->skip;
+
+	/* Decimal places of the ratio carry over like those of a step */
+	if (CHECK_FLAG(scaffold->flags, FLAG_GEOMETRIC) && HAS_STEP(scaffold)) {
+		INCREASE_PRECISION(*scaffold, calc_precision(scaffold->step));
+	}
+
 	if (KNOWN(scaffold) == 1) {
 		if (! HAS_LEFT(scaffold)) {
 			SET_LEFT(*scaffold, 1.0f);
@@ -134,6 +284,10 @@ void complete_scaffold(scaffolding * scaffold) {
 			scaffold->flags |= FLAG_READY;
 			assert(! HAS_COUNT(scaffold) && ! HAS_RIGHT(scaffold));
 			assert(KNOWN(scaffold) == 2);
+
+			if (scaffold->shard_count > 0) {
+				select_shard(scaffold);
+			}
 			return;
 		}
 
@@ -150,6 +304,13 @@ void complete_scaffold(scaffolding * scaffold) {
 				assert(HAS_STEP(scaffold));
 				if (CHECK_FLAG(scaffold->flags, FLAG_RANDOM)) {
 					SET_LEFT(*scaffold, 1.0);
+				} else if (CHECK_FLAG(scaffold->flags, FLAG_GEOMETRIC)) {
+					/* Smallest power of the ratio reaching right */
+					const double powers = floor(log(fabs(scaffold->right))
+						/ log(scaffold->step));
+					SET_LEFT(*scaffold, (powers >= 0)
+						? scaffold->right / power_of(scaffold->step, (unsigned long)powers)
+						: scaffold->right * power_of(scaffold->step, (unsigned long)-powers));
 				} else {
 					SET_LEFT(*scaffold, scaffold->right
 						- scaffold->step * floor(
@@ -167,6 +328,10 @@ void complete_scaffold(scaffolding * scaffold) {
 		if (! HAS_LEFT(scaffold)) {
 			if (CHECK_FLAG(scaffold->flags, FLAG_RANDOM)) {
 				SET_LEFT(*scaffold, 1.0);
+			} else if (CHECK_FLAG(scaffold->flags, FLAG_GEOMETRIC)) {
+				SET_LEFT(*scaffold, (scaffold->count > 1)
+					? scaffold->right / power_of(scaffold->step, scaffold->count - 1)
+					: scaffold->right);
 			} else {
 				SET_LEFT(*scaffold, scaffold->right - (scaffold->count - 1)
 					* scaffold->step);
@@ -174,6 +339,22 @@ void complete_scaffold(scaffolding * scaffold) {
 		} else if (! HAS_COUNT(scaffold)) {
 			if (CHECK_FLAG(scaffold->flags, FLAG_RANDOM)) {
 				SET_COUNT(*scaffold, 1);
+			} else if (CHECK_FLAG(scaffold->flags, FLAG_GEOMETRIC)) {
+				/* Estimate, then correct for rounding of the logarithm */
+				unsigned long count = 1;
+
+				ensure_proper_ratio(scaffold);
+				if (scaffold->left != scaffold->right) {
+					count = (unsigned long)floor(distance_in_steps(scaffold, scaffold->right)) + 1;
+					while ((count > 1) && ! check_candidate(scaffold,
+							calc_candidate(scaffold, count - 1))) {
+						count--;
+					}
+					while (check_candidate(scaffold, calc_candidate(scaffold, count))) {
+						count++;
+					}
+				}
+				SET_COUNT(*scaffold, count);
 			} else {
 				assert(HAS_STEP(scaffold));
 				assert(HAS_LEFT(scaffold));
@@ -181,15 +362,15 @@ void complete_scaffold(scaffolding * scaffold) {
 
 				ensure_proper_step_sign(scaffold);
 				{
-					int count_candidate =
+					double count_candidate =
 						ceil(fabs(scaffold->right - scaffold->left)
 						/ fabs(scaffold->step) + 1);
 
 					/* Will values be running over right? */
 					/* For instance for "enum 1 .. 2 .. 4" count must be 2, not 3. */
-					const float last = scaffold->left
+					const double last = scaffold->left
 						+ scaffold->step * (count_candidate - 1);
-					const float over_by = (scaffold->step > 0)
+					const double over_by = (scaffold->step > 0)
 						? last - scaffold->right
 						: scaffold->right - last;
 					if (over_by > FLOAT_EQUAL_DELTA) {
@@ -197,12 +378,20 @@ void complete_scaffold(scaffolding * scaffold) {
 					}
 
 					assert(count_candidate > 0);
-					SET_COUNT(*scaffold, (unsigned int)count_candidate);
+					SET_COUNT(*scaffold, (unsigned long)count_candidate);
 				}
 			}
 		} else if (! HAS_STEP(scaffold)) {
-			if (CHECK_FLAG(scaffold->flags, FLAG_RANDOM)) {
+			/* Random values and walks stay on the grid of the arguments */
+			if (CHECK_FLAG(scaffold->flags, FLAG_RANDOM) || (scaffold->walk != WALK_NONE)) {
 				SET_STEP(*scaffold, precision_to_step(scaffold->auto_precision));
+			} else if (CHECK_FLAG(scaffold->flags, FLAG_GEOMETRIC)) {
+				/* Logarithmically spaced */
+				SET_STEP(*scaffold, (scaffold->count > 1)
+					? pow(scaffold->right / scaffold->left, 1.0 / (scaffold->count - 1))
+					: 1.0);
+				/* correct precision */
+				INCREASE_PRECISION(*scaffold, calc_precision(scaffold->step));
 			} else {
 				if (scaffold->count == 1) {
 					SET_STEP(*scaffold, 0.0);
@@ -217,6 +406,9 @@ void complete_scaffold(scaffolding * scaffold) {
 			assert(! HAS_RIGHT(scaffold));
 			if (scaffold->count == 1) {
 				SET_RIGHT(*scaffold, scaffold->left);
+			} else if (CHECK_FLAG(scaffold->flags, FLAG_GEOMETRIC)) {
+				SET_RIGHT(*scaffold, scaffold->left
+					* power_of(scaffold->step, scaffold->count - 1));
 			} else {
 				SET_RIGHT(*scaffold, scaffold->left + scaffold->step
 					* (scaffold->count - 1));
@@ -227,7 +419,19 @@ void complete_scaffold(scaffolding * scaffold) {
 	scaffold->flags |= FLAG_READY;
 	assert(KNOWN(scaffold) == 4);
 
-	ensure_proper_step_sign(scaffold);
+	if (CHECK_FLAG(scaffold->flags, FLAG_GEOMETRIC)) {
+		ensure_proper_ratio(scaffold);
+	} else {
+		ensure_proper_step_sign(scaffold);
+	}
+
+	if (CHECK_FLAG(scaffold->flags, FLAG_REVERSE)) {
+		count_values(scaffold, &(scaffold->reverse_count));
+	}
+
+	if (scaffold->shard_count > 0) {
+		select_shard(scaffold);
+	}
 }
 
 /** Calculate a random value out of possible output values.
@@ -243,9 +447,9 @@ void complete_scaffold(scaffolding * scaffold) {
  *
  * @since 0.3
  */
-static float discrete_random_closed(float min, float max, float step_width) {
-	const float original_distance = fabs(max - min);
-	const float distance = original_distance
+static double discrete_random_closed(double min, double max, double step_width) {
+	const double original_distance = fabs(max - min);
+	const double distance = original_distance
 		- fmod(original_distance, step_width) + step_width;
 	double zero_to_almost_one = 0;
 	double zero_to_almost_distance;
@@ -272,43 +476,146 @@ static float discrete_random_closed(float min, float max, float step_width) {
 	return min + zero_to_almost_distance - fmod(zero_to_almost_distance, step_width);
 }
 
-/** Calculate a candidate for output.
+/** Calculate a random value out of possible output values without bias.
  *
- * Based on known values, calculate a possible candidate for enum_yield to
- * place into scaffold or check if there will be another valid one.
+ * In contrast to discrete_random_closed() each value on the grid from min
+ * towards max is picked with exactly the same probability, given uniform
+ * random bits.
  *
- * @param[in] scaffold
+ * @param[in] min
+ * @param[in] max
+ * @param[in] step_width
  *
- * @return A calculated candidate for enum_yield to place into scaffold
+ * @return A random value within given range considering step
  *
- * @since 0.5
+ * @since 1.2
  */
-static float calc_candidate(scaffolding const * scaffold) {
-	if (! CHECK_FLAG(scaffold->flags, FLAG_USER_STEP)
-			&& HAS_RIGHT(scaffold) && HAS_COUNT(scaffold)) {
-		return  scaffold->left + (scaffold->right - scaffold->left)
-			/ (scaffold->count - 1) * scaffold->position;
-	} else {
-		return scaffold->left + scaffold->step * scaffold->position;
+static double discrete_random_unbiased(double min, double max, double step_width) {
+	double last_index;
+
+	if (min == max) {
+		return min;
 	}
-	/* TODO check for float overflow, float imprecision */
+	assert(min < max);
+	assert(step_width > 0);
+
+	last_index = floor((max - min + FLOAT_EQUAL_DELTA) / step_width);
+	return min + enum_random_index(last_index + 1) * step_width;
 }
 
-/** Checks a candidate for validity.
+/** Calculate a value out of possible output values from a low-discrepancy sequence.
  *
- * @param[in] scaffold Settings to apply
+ * The point of the sequence at the current position is mapped onto the
+ * grid from min towards max, so that --skip and --shard enter the
+ * sequence at the right point.
  *
- * @return Validity bool (1 means valid, 0 mean invalid)
+ * @param[in,out] scaffold
  *
- * @since 0.5
+ * @return A value within given range considering step
+ *
+ * @since 1.2
  */
-static int check_candidate(scaffolding const * scaffold, float candidate) {
-	if (HAS_RIGHT(scaffold)
-			&& (((scaffold->left <= scaffold->right) && ((candidate - scaffold->right) > FLOAT_EQUAL_DELTA))
-				|| ((scaffold->left >= scaffold->right) && (scaffold->right - candidate) > FLOAT_EQUAL_DELTA))) {
-		return 0;
+static double discrete_quasi(scaffolding * scaffold) {
+	const double min = ENUM_MIN(scaffold->left, scaffold->right);
+	const double max = ENUM_MAX(scaffold->left, scaffold->right);
+	const double step_width = fabs(scaffold->step);
+	double last_index;
+
+	if ((min == max) || (step_width == 0)) {
+		return min;
 	}
-	return 1;
+
+	last_index = floor((max - min + FLOAT_EQUAL_DELTA) / step_width);
+	return min + floor(quasi_point(&(scaffold->quasi), scaffold->position)
+		* (last_index + 1)) * step_width;
+}
+
+/** Calculate a random value following a non-uniform distribution.
+ *
+ * A value is drawn from the distribution selected in the scaffold and
+ * snapped to the closest point of the grid running from left towards
+ * right by step.  Values falling outside of the range are redrawn.  If a
+ * distribution hardly overlaps with the range, the closest border is
+ * returned after MAX_RANDOM_REDRAWS attempts.
+ *
+ * @param[in] scaffold
+ *
+ * @return A random value within given range considering step
+ *
+ * @since 1.2
+ */
+static double discrete_random_distributed(scaffolding const * scaffold) {
+	const double min = ENUM_MIN(scaffold->left, scaffold->right);
+	const double max = ENUM_MAX(scaffold->left, scaffold->right);
+	const double step_width = fabs(scaffold->step);
+	const double direction = (scaffold->left <= scaffold->right) ? +1.0 : -1.0;
+	const double last_index = floor((max - min + FLOAT_EQUAL_DELTA) / step_width);
+	const double * const args = scaffold->distribution_args;
+	const unsigned int argc = scaffold->distribution_argc;
+	double value = scaffold->left;
+	unsigned int attempt;
+
+	if (min == max) {
+		return min;
+	}
+	assert(step_width > 0);
+
+	for (attempt = 0; attempt < MAX_RANDOM_REDRAWS; attempt++) {
+		double index;
+
+		switch (scaffold->distribution) {
+		case DISTRIBUTION_NORMAL:
+			{
+				const double mean = (argc >= 1) ? args[0] : (min + max) / 2;
+				const double deviation = (argc >= 2) ? args[1] : (max - min) / 6;
+				value = mean + deviation * enum_random_normal();
+			}
+			break;
+		case DISTRIBUTION_EXPONENTIAL:
+			{
+				const double rate = (argc >= 1) ? args[0] : 1.0;
+				value = scaffold->left + direction * enum_random_exponential() / rate;
+			}
+			break;
+		case DISTRIBUTION_LOG_NORMAL:
+			{
+				const double mu = (argc >= 1) ? args[0] : 0.0;
+				const double sigma = (argc >= 2) ? args[1] : 1.0;
+				value = scaffold->left + direction
+					* exp(mu + sigma * enum_random_normal());
+			}
+			break;
+		case DISTRIBUTION_ZIPF:
+			{
+				/* Rank 1 maps to left, the last rank to the last grid point */
+				const double exponent = (argc >= 1) ? args[0] : 1.0;
+				const double rank = enum_random_zipf(exponent, last_index + 1);
+				return scaffold->left + direction * (rank - 1) * step_width;
+			}
+		default:
+			assert(0);
+		}
+
+		index = floor(direction * (value - scaffold->left) / step_width + 0.5);
+		if ((index >= 0) && (index <= last_index)) {
+			return scaffold->left + direction * index * step_width;
+		}
+	}
+
+	return (value < min) ? min : max;
+}
+
+/** Checks whether the window selected by --limit has been used up.
+ *
+ * @param[in] scaffold
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int reached_limit(scaffolding const * scaffold) {
+	return CHECK_FLAG(scaffold->flags, FLAG_LIMIT_SET)
+		&& (scaffold->position - scaffold->skip >= scaffold->limit);
 }
 
 /** Main output function.
@@ -328,8 +635,8 @@ static int check_candidate(scaffolding const * scaffold, float candidate) {
  *
  * @since 0.3
  */
-yield_status enum_yield(scaffolding * scaffold, float * dest) {
-	float candidate;
+yield_status enum_yield(scaffolding * scaffold, double * dest) {
+	double candidate;
 
 	assert(CHECK_FLAG(scaffold->flags, FLAG_READY));
 
@@ -338,12 +645,23 @@ yield_status enum_yield(scaffolding * scaffold, float * dest) {
 
 		assert(HAS_RIGHT(scaffold));
 
-		*dest = discrete_random_closed(
-			ENUM_MIN(scaffold->left, scaffold->right),
-			ENUM_MAX(scaffold->left, scaffold->right),
-			fabs(scaffold->step));
+		if (scaffold->quasi.type != QUASI_NONE) {
+			*dest = discrete_quasi(scaffold);
+		} else if (scaffold->distribution != DISTRIBUTION_UNIFORM) {
+			*dest = discrete_random_distributed(scaffold);
+		} else if (CHECK_FLAG(scaffold->flags, FLAG_SECURE)) {
+			*dest = discrete_random_unbiased(
+				ENUM_MIN(scaffold->left, scaffold->right),
+				ENUM_MAX(scaffold->left, scaffold->right),
+				fabs(scaffold->step));
+		} else {
+			*dest = discrete_random_closed(
+				ENUM_MIN(scaffold->left, scaffold->right),
+				ENUM_MAX(scaffold->left, scaffold->right),
+				fabs(scaffold->step));
+		}
 		scaffold->position++;
-		if (scaffold->position == scaffold->count) {
+		if ((scaffold->position == scaffold->count) || reached_limit(scaffold)) {
 			return YIELD_LAST;
 		} else {
 			return YIELD_MORE;
@@ -357,28 +675,46 @@ yield_status enum_yield(scaffolding * scaffold, float * dest) {
 	if (HAS_COUNT(scaffold))
 		assert(scaffold->position < scaffold->count);
 
+	/* Walking backwards from the last value? */
+	if (CHECK_FLAG(scaffold->flags, FLAG_REVERSE)) {
+		*dest = value_at_position(scaffold, scaffold->position);
+		scaffold->position++;
+		if ((scaffold->position == scaffold->reverse_count) || reached_limit(scaffold)) {
+			return YIELD_LAST;
+		}
+		return YIELD_MORE;
+	}
+
 	/* One value only? */
 	if (HAS_COUNT(scaffold) && (scaffold->count == 1)) {
 		*dest = scaffold->left;
 		return YIELD_LAST;
 	}
 
-	candidate = calc_candidate(scaffold);
+	candidate = calc_candidate(scaffold, scaffold->position);
 
 	/* Gone too far now? */
 	assert(check_candidate(scaffold, candidate));
 
 	*dest = candidate;
+
+	/* Positions end at ULONG_MAX, even with infinite ranges */
+	if (scaffold->position == ULONG_MAX) {
+		return YIELD_LAST;
+	}
 	scaffold->position++;
 
 	/* Will there be more? */
 	if ((HAS_COUNT(scaffold) && (scaffold->position == scaffold->count))
+			|| reached_limit(scaffold)
 			|| (HAS_RIGHT(scaffold) && (*dest == scaffold->right))) {
 		return YIELD_LAST;
 	} else {
 		/* Going too far next time? (position has already been increased) */
-		const float future_candidate = calc_candidate(scaffold);
-		if (! check_candidate(scaffold, future_candidate)) {
+		const double future_candidate = calc_candidate(scaffold, scaffold->position);
+		/* Geometric values overflowing to infinity end output, too */
+		if (! check_candidate(scaffold, future_candidate)
+				|| (fabs(future_candidate) > DBL_MAX)) {
 			return YIELD_LAST;
 		}
 		return YIELD_MORE;
@@ -401,4 +737,473 @@ void initialize_scaffold(scaffolding * dest) {
 	dest->format = NULL;
 	dest->separator = NULL;
 	dest->terminator = NULL;
+	dest->distribution = DISTRIBUTION_UNIFORM;
+	dest->distribution_argc = 0;
+	dest->skip = 0;
+	dest->limit = 0;
+	dest->shard_index = 0;
+	dest->shard_count = 0;
+	dest->chunk_count = 0;
+	dest->chunk_align = 1;
+	dest->query = QUERY_NONE;
+	dest->aggregates = 0;
+	dest->reverse_count = 0;
+	dest->verify_file = NULL;
+	dest->dimensions = NULL;
+	dest->dimension_count = 0;
+	dest->field_separator = NULL;
+	dest->field_formats = NULL;
+	dest->field_format_count = 0;
+	dest->order = ORDER_ROW;
+	dest->tile_size = DEFAULT_TILE_SIZE;
+	dest->operation = SET_NONE;
+	dest->ratio = 0;
+	dest->time_format = NULL;
+	dest->alphabet = NULL;
+	dest->string_length = 0;
+	dest->string_alphabet = NULL;
+	dest->choice_file = NULL;
+	dest->weights_file = NULL;
+	dest->walk = WALK_NONE;
+	quasi_init(&dest->quasi, QUASI_NONE, 0);
+}
+
+/** Calculate the number of values a scaffold will yield.
+ *
+ * The number is derived in constant time from left, right and step, and
+ * then corrected in a few steps so that it matches the stop conditions of
+ * enum_yield exactly, i.e. including check_candidate() tolerance and
+ * hitting right early.  Skip and limit are not taken into account.
+ *
+ * @param[in] scaffold Completed scaffold
+ * @param[out] dest Number of values
+ *
+ * @return 1 for finite output, 0 for infinite output (dest untouched)
+ *
+ * @since 1.2
+ */
+int count_values(scaffolding const * scaffold, unsigned long * dest) {
+	unsigned long count;
+
+	assert(CHECK_FLAG(scaffold->flags, FLAG_READY));
+
+	if (! HAS_COUNT(scaffold)) {
+		return 0;
+	}
+
+	count = scaffold->count;
+	/* Random values and walks take their number from count, right only
+	 * bounds them */
+	if (! CHECK_FLAG(scaffold->flags, FLAG_RANDOM)
+			&& (scaffold->walk == WALK_NONE) && (count > 1)) {
+		if (scaffold->left == scaffold->right) {
+			count = 1;
+		} else if (CHECK_FLAG(scaffold->flags, FLAG_USER_STEP)) {
+			const double estimate = floor(distance_in_steps(scaffold, scaffold->right)) + 1;
+			if (estimate < count) {
+				count = (unsigned long)estimate;
+			}
+
+			while ((count > 1) && ! check_candidate(scaffold,
+					calc_candidate(scaffold, count - 1))) {
+				count--;
+			}
+			while ((count < scaffold->count)
+					&& (calc_candidate(scaffold, count - 1) != scaffold->right)
+					&& check_candidate(scaffold, calc_candidate(scaffold, count))) {
+				count++;
+			}
+		}
+
+		/* Hitting right exactly ends output, too */
+		while ((count > 1) && (calc_candidate(scaffold, count - 2) == scaffold->right)) {
+			count--;
+		}
+	}
+
+	*dest = count;
+	return 1;
+}
+
+/** Calculate the number of values selected by skip and limit.
+ *
+ * @param[in] scaffold Completed scaffold
+ * @param[out] dest Number of values
+ *
+ * @return 1 for finite output, 0 for infinite output (dest untouched)
+ *
+ * @since 1.2
+ */
+int count_window(scaffolding const * scaffold, unsigned long * dest) {
+	unsigned long total;
+
+	if (! count_values(scaffold, &total)) {
+		if (! CHECK_FLAG(scaffold->flags, FLAG_LIMIT_SET)) {
+			return 0;
+		}
+		*dest = scaffold->limit;
+		return 1;
+	}
+
+	total = (total > scaffold->skip) ? total - scaffold->skip : 0;
+	if (CHECK_FLAG(scaffold->flags, FLAG_LIMIT_SET) && (scaffold->limit < total)) {
+		total = scaffold->limit;
+	}
+
+	*dest = total;
+	return 1;
+}
+
+/** Calculate the value at a given position of a completed scaffold.
+ *
+ * In contrast to enum_yield, the scaffold is left untouched.  The position
+ * is expected to be lower than the number reported by count_values.  With
+ * FLAG_REVERSE, positions count backwards from the last value.
+ *
+ * @param[in] scaffold Completed scaffold
+ * @param[in] position Position of the value, counting from 0
+ *
+ * @return Value at given position
+ *
+ * @since 1.2
+ */
+double value_at_position(scaffolding const * scaffold, unsigned long position) {
+	assert(CHECK_FLAG(scaffold->flags, FLAG_READY));
+	assert(! CHECK_FLAG(scaffold->flags, FLAG_RANDOM));
+
+	if (CHECK_FLAG(scaffold->flags, FLAG_REVERSE)) {
+		assert(position < scaffold->reverse_count);
+		position = scaffold->reverse_count - 1 - position;
+	}
+
+	if (HAS_COUNT(scaffold) && (scaffold->count == 1)) {
+		return scaffold->left;
+	}
+	return calc_candidate(scaffold, position);
+}
+
+/** Find the position of a value in a completed scaffold.
+ *
+ * The position is derived in constant time.  Like with check_candidate(),
+ * a value is considered found if it is off by FLOAT_EQUAL_DELTA at most.
+ * Skip and limit are not taken into account, FLAG_REVERSE is.
+ *
+ * @param[in] scaffold Completed scaffold
+ * @param[in] value Value to look for
+ * @param[out] dest Position of the value, counting from 0
+ *
+ * @return 1 if found, 0 otherwise (dest untouched)
+ *
+ * @since 1.2
+ */
+int position_of_value(scaffolding const * scaffold, double value, unsigned long * dest) {
+	unsigned long position = 0;
+	unsigned long total;
+
+	assert(CHECK_FLAG(scaffold->flags, FLAG_READY));
+	assert(! CHECK_FLAG(scaffold->flags, FLAG_RANDOM));
+
+	if (CHECK_FLAG(scaffold->flags, FLAG_GEOMETRIC)) {
+		const double estimate = (value / scaffold->left > 0)
+			? floor(log(value / scaffold->left) / log(scaffold->step) + 0.5)
+			: 0;
+
+		if (estimate >= (double)ULONG_MAX) {
+			return 0;
+		} else if (estimate > 0) {
+			position = (unsigned long)estimate;
+		}
+	} else if (! HAS_COUNT(scaffold) || (scaffold->count > 1)) {
+		const double distance = (! CHECK_FLAG(scaffold->flags, FLAG_USER_STEP)
+				&& HAS_RIGHT(scaffold) && HAS_COUNT(scaffold))
+			? (scaffold->right - scaffold->left) / (scaffold->count - 1)
+			: scaffold->step;
+		const double estimate = (distance == 0)
+			? 0
+			: floor((value - scaffold->left) / distance + 0.5);
+
+		if (estimate >= (double)ULONG_MAX) {
+			return 0;
+		} else if (estimate > 0) {
+			position = (unsigned long)estimate;
+		}
+	}
+
+	if (count_values(scaffold, &total)) {
+		if (total == 0) {
+			return 0;
+		}
+		position = ENUM_MIN(position, total - 1);
+	}
+
+	if (CHECK_FLAG(scaffold->flags, FLAG_REVERSE)) {
+		position = scaffold->reverse_count - 1 - position;
+	}
+
+	if (fabs(value_at_position(scaffold, position) - value) > FLOAT_EQUAL_DELTA) {
+		return 0;
+	}
+
+	*dest = position;
+	return 1;
+}
+
+/** Store a default format string to scaffold.
+ *
+ * A default format string, consisting of a floating point number with decimal
+ * places according to given precision, is created in allocated memory and then
+ * stored into a scaffold's format key, scaffold->format.
+ *
+ * @param[in,out] dest
+ * @param[in] precision
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 0.4
+ */
+int make_default_format_string(scaffolding * dest, unsigned int precision) {
+	char * newformat = NULL;
+	const size_t post_dot_bytes_needed = ((precision == 0) ? 0 : (size_t)log10(precision)) + 1;
+
+	if (HAS_RIGHT(dest) && CHECK_FLAG(dest->flags, FLAG_EQUAL_WIDTH)) {
+		const char * const equal_width_base = "%%0%u.%uf";
+		const int left_len = (dest->left < 0) + (size_t)log10(fabs(dest->left)) + 1;
+		const int right_len = (dest->right < 0) + (size_t)log10(fabs(dest->right)) + 1;
+		const unsigned int pre_dot_digits_wanted = ENUM_MAX(left_len, right_len);
+		const unsigned int total_chars_wanted = pre_dot_digits_wanted + (precision ? 1 + precision : 0);
+		const size_t pre_dot_bytes_needed = (size_t)log10(total_chars_wanted) + 1;
+		const size_t base_bytes = strlen(equal_width_base)
+			- strlen("%")
+			- strlen("%u") + pre_dot_bytes_needed
+			- strlen("%u") + post_dot_bytes_needed
+			+ 1;
+		newformat = (char *)malloc(base_bytes);
+		if (! newformat)
+		    return 0;
+		sprintf(newformat, equal_width_base, total_chars_wanted, precision);
+	} else {
+		const char * const default_base = "%%.%uf";
+		const size_t base_bytes = strlen(default_base)
+			- strlen("%")
+			- strlen("%u") + post_dot_bytes_needed
+			+ 1;
+		newformat = (char *)malloc(base_bytes);
+		if (! newformat)
+		    return 0;
+		sprintf(newformat, default_base, precision);
+	}
+
+	assert(! dest->format);
+	dest->format = newformat;
+	return 1;
+}
+
+/** Base and number of limbs of exact sums, see exact_integer_sum()
+ *
+ * Products of two limbs fit into 32 bits.
+ *
+ * @since 1.2
+ */
+#define SUM_LIMB_BASE  10000
+#define SUM_LIMB_COUNT  12
+
+/** Split a non-negative integer into limbs, least significant first.
+ *
+ * @param[in] magnitude Integer of magnitude up to 2^54
+ * @param[out] limbs SUM_LIMB_COUNT limbs
+ *
+ * @since 1.2
+ */
+static void to_sum_limbs(double magnitude, unsigned long * limbs) {
+	unsigned int i;
+
+	for (i = 0; i < SUM_LIMB_COUNT; i++) {
+		limbs[i] = (unsigned long)fmod(magnitude, SUM_LIMB_BASE);
+		/* Exact, the difference is a multiple of the base */
+		magnitude = (magnitude - limbs[i]) / SUM_LIMB_BASE;
+	}
+}
+
+/** Add limbs b to limbs a.
+ *
+ * @param[in,out] a SUM_LIMB_COUNT limbs
+ * @param[in] b SUM_LIMB_COUNT limbs
+ *
+ * @since 1.2
+ */
+static void add_sum_limbs(unsigned long * a, const unsigned long * b) {
+	unsigned long carry = 0;
+	unsigned int i;
+
+	for (i = 0; i < SUM_LIMB_COUNT; i++) {
+		a[i] += b[i] + carry;
+		carry = a[i] / SUM_LIMB_BASE;
+		a[i] %= SUM_LIMB_BASE;
+	}
+}
+
+/** Write the sum of an arithmetic progression of integers in decimal.
+ *
+ * The sum is count * (first + last) / 2, calculated in limbs so that
+ * no digits are lost beyond 2^53.
+ *
+ * @param[in] count Number of values
+ * @param[in] first First value, an integer of magnitude up to 2^53
+ * @param[in] last Last value, an integer of magnitude up to 2^53
+ * @param[out] dest At least AGGREGATE_SUM_SIZE bytes
+ *
+ * @since 1.2
+ */
+static void exact_integer_sum(unsigned long count, double first, double last, char * dest) {
+	unsigned long ends[SUM_LIMB_COUNT];
+	unsigned long counts[SUM_LIMB_COUNT];
+	unsigned long product[SUM_LIMB_COUNT];
+	unsigned long remainder = 0;
+	int negative;
+	int top;
+	unsigned int i;
+	unsigned int j;
+
+	/* Magnitude of first + last, exact even beyond 2^53 */
+	if ((first < 0) == (last < 0)) {
+		unsigned long other[SUM_LIMB_COUNT];
+
+		to_sum_limbs(fabs(first), ends);
+		to_sum_limbs(fabs(last), other);
+		add_sum_limbs(ends, other);
+		negative = (first < 0);
+	} else {
+		to_sum_limbs(fabs(first + last), ends);
+		negative = (first + last < 0);
+	}
+
+	for (i = 0; i < SUM_LIMB_COUNT; i++) {
+		counts[i] = count % SUM_LIMB_BASE;
+		count /= SUM_LIMB_BASE;
+		product[i] = 0;
+	}
+
+	for (i = 0; i < SUM_LIMB_COUNT; i++) {
+		unsigned long carry = 0;
+
+		for (j = 0; i + j < SUM_LIMB_COUNT; j++) {
+			product[i + j] += counts[i] * ends[j] + carry;
+			carry = product[i + j] / SUM_LIMB_BASE;
+			product[i + j] %= SUM_LIMB_BASE;
+		}
+	}
+
+	/* Halve, the product is even for integer values */
+	for (top = SUM_LIMB_COUNT - 1; top >= 0; top--) {
+		const unsigned long current = remainder * SUM_LIMB_BASE + product[top];
+
+		product[top] = current / 2;
+		remainder = current % 2;
+	}
+	assert(remainder == 0);
+
+	top = SUM_LIMB_COUNT - 1;
+	while ((top > 0) && (product[top] == 0)) {
+		top--;
+	}
+	if ((top == 0) && (product[0] == 0)) {
+		negative = 0;
+	}
+
+	dest += sprintf(dest, negative ? "-%lu" : "%lu", product[top]);
+	while (--top >= 0) {
+		dest += sprintf(dest, "%04lu", product[top]);
+	}
+}
+
+/** Calculate aggregates of the values selected by skip and limit.
+ *
+ * For sequences, the values selected are an arithmetic or geometric
+ * progression so that all aggregates follow from the first and the last
+ * value.  Random values are drawn and accumulated.
+ *
+ * @param[in,out] scaffold Completed scaffold
+ * @param[in] window Number of values selected, as told by count_window
+ * @param[out] dest Aggregates
+ *
+ * @since 1.2
+ */
+void aggregate_window(scaffolding * scaffold, unsigned long window, aggregate_values * dest) {
+	dest->sum = 0;
+	dest->min = 0;
+	dest->max = 0;
+	dest->exact_sum[0] = '\0';
+
+	if (window == 0) {
+		/* Nothing to add up */
+	} else if (CHECK_FLAG(scaffold->flags, FLAG_RANDOM)) {
+		double compensation = 0;
+		unsigned long i;
+
+		for (i = 0; i < window; i++) {
+			double value;
+			double corrected;
+			double total;
+
+			enum_yield(scaffold, &value);
+			if ((i == 0) || (value < dest->min)) {
+				dest->min = value;
+			}
+			if ((i == 0) || (value > dest->max)) {
+				dest->max = value;
+			}
+
+			/* Kahan summation to keep billions of values accurate */
+			corrected = value - compensation;
+			total = dest->sum + corrected;
+			compensation = (total - dest->sum) - corrected;
+			dest->sum = total;
+		}
+	} else {
+		const double first = value_at_position(scaffold, scaffold->skip);
+		const double last = value_at_position(scaffold, scaffold->skip + window - 1);
+
+		dest->min = ENUM_MIN(first, last);
+		dest->max = ENUM_MAX(first, last);
+		if (CHECK_FLAG(scaffold->flags, FLAG_GEOMETRIC) && (window > 1)) {
+			/* Geometric series */
+			const double ratio = CHECK_FLAG(scaffold->flags, FLAG_REVERSE)
+				? 1 / scaffold->step
+				: scaffold->step;
+			dest->sum = (last * ratio - first) / (ratio - 1);
+		} else {
+			dest->sum = (first + last) / 2 * window;
+
+			/* Integers have an exact sum, even beyond 2^53 */
+			if ((floor(first) == first) && (floor(last) == last)
+					&& (floor(scaffold->step) == scaffold->step)
+					&& (fabs(first) <= PROGRESSION_MAX_EXACT)
+					&& (fabs(last) <= PROGRESSION_MAX_EXACT)) {
+				exact_integer_sum(window, first, last, dest->exact_sum);
+			}
+		}
+	}
+}
+
+/** Split a number of items into contiguous parts of balanced size.
+ *
+ * Sizes of the parts differ by one at most, the larger parts coming last.
+ *
+ * @param[in] total Number of items to split
+ * @param[in] parts Number of parts
+ * @param[in] index Part of interest, counting from 0
+ * @param[out] offset Number of items in front of the part
+ * @param[out] size Number of items in the part
+ *
+ * @since 1.2
+ */
+void split_evenly(unsigned long total, unsigned long parts, unsigned long index,
+		unsigned long * offset, unsigned long * size) {
+	const unsigned long base = total / parts;
+	const unsigned long smaller = parts - total % parts;
+
+	assert(index < parts);
+
+	*offset = index * base + ((index > smaller) ? index - smaller : 0);
+	*size = base + ((index >= smaller) ? 1 : 0);
 }
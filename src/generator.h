@@ -41,6 +41,11 @@
 #define GENERATOR_H 1
 
 #include "utils.h" /* for CHECK_FLAG */
+#include "random.h" /* for distribution_type */
+#include "ordering.h" /* for tuple_order */
+#include "progression.h" /* for set_operation */
+#include "quasi.h" /* for quasi_sequence */
+#include "walk.h" /* for walk_type */
 
 /** @name Constants
  * Constants used by generator
@@ -50,6 +55,8 @@
 /*@{*/
 #define MAX_POST_DOT_DIGITS  5
 #define FLOAT_EQUAL_DELTA  0.0001f
+#define MAX_DISTRIBUTION_ARGS  2
+#define MAX_RANDOM_REDRAWS  1000
 /*@}*/
 
 /** @name Macros to set scaffold values
@@ -140,9 +147,64 @@ enum scaffolding_flags {
 	FLAG_USER_PRECISION = 1 << 7,
 	FLAG_EQUAL_WIDTH = 1 << 8,
 	FLAG_USER_SEED = 1 << 9,
-	FLAG_NULL_BYTES = 1 << 10
+	FLAG_NULL_BYTES = 1 << 10,
+	FLAG_SECURE = 1 << 11,
+	FLAG_LIMIT_SET = 1 << 12,
+	FLAG_REVERSE = 1 << 13,
+	FLAG_PREDICT_SIZE = 1 << 14,
+	FLAG_DIGEST = 1 << 15,
+	FLAG_ZIP = 1 << 16,
+	FLAG_CONCAT = 1 << 17,
+	FLAG_EXCEPT = 1 << 18,
+	FLAG_GEOMETRIC = 1 << 19,
+	FLAG_TIME = 1 << 20,
+	FLAG_PRIMES = 1 << 21,
+	FLAG_FROM_STDIN = 1 << 22,
+	FLAG_NUMBER_LINES = 1 << 23
 };
 
+/** Enumeration of questions to answer instead of printing values
+ *
+ * @since 1.2
+ */
+typedef enum _query_type {
+	QUERY_NONE,     /**< print values (default) */
+	QUERY_NTH,      /**< print value at given position */
+	QUERY_INDEX_OF, /**< print position of given value */
+	QUERY_CONTAINS  /**< report presence of given value by exit code */
+} query_type;
+
+/** Enumeration for aggregates set in scaffold->aggregates
+ *
+ * @since 1.2
+ */
+enum aggregate_flags {
+	AGGREGATE_SUM = 1 << 0,
+	AGGREGATE_COUNT = 1 << 1,
+	AGGREGATE_MIN = 1 << 2,
+	AGGREGATE_MAX = 1 << 3,
+	AGGREGATE_MEAN = 1 << 4
+};
+
+/** Size of aggregate_values.exact_sum, enough for the sum of ULONG_MAX
+ * integers of magnitude up to 2^53
+ *
+ * @since 1.2
+ */
+#define AGGREGATE_SUM_SIZE  52
+
+/** Aggregates of the values selected, see aggregate_window()
+ *
+ * @since 1.2
+ */
+typedef struct _aggregate_values {
+	double sum;  /**< sum of all values */
+	double min;  /**< smallest value (0 for no values) */
+	double max;  /**< largest value (0 for no values) */
+	char exact_sum[AGGREGATE_SUM_SIZE];  /**< sum in decimal digits if all values
+	                                       are integers, empty otherwise */
+} aggregate_values;
+
 /** Enumeration of possible return states of enum_yield() */
 typedef enum _yield_status {
 	YIELD_MORE, /**< value calculated, more available */
@@ -156,21 +218,61 @@ typedef enum _yield_status {
  */
 typedef struct _scaffolding {
 	int flags;              /**< store for flags to indicate set values */
-	float left;             /**< lower border of return values */
-	float right;            /**< upper border of return values */
-	float step;             /**< step between values */
-	unsigned int count;     /**< number of values to return */
-	unsigned int position;  /**< current position while walking through values */
+	double left;            /**< lower border of return values */
+	double right;           /**< upper border of return values */
+	double step;            /**< step between values, ratio with FLAG_GEOMETRIC */
+	unsigned long count;    /**< number of values to return */
+	unsigned long position; /**< current position while walking through values */
 	unsigned int auto_precision; /**< derived number of decimal places for future output format */
 	unsigned int user_precision; /**< number of decimal places for future output format specified by user */
 	char * format;          /**< output format string */
 	char * separator;       /**< separation string between output values (default: \n) */
 	unsigned int seed;      /**< seed used to init random number generator */
 	char * terminator;      /**< terminating string for output (default: \n) */
+	distribution_type distribution; /**< distribution of random values (default: uniform) */
+	double distribution_args[MAX_DISTRIBUTION_ARGS]; /**< parameters of the distribution */
+	unsigned int distribution_argc; /**< number of parameters specified by user */
+	unsigned long skip;     /**< number of leading values to leave out */
+	unsigned long limit;    /**< maximum number of values to return */
+	unsigned long shard_index; /**< shard to print, counting from 1 */
+	unsigned long shard_count; /**< number of shards (0: no sharding) */
+	unsigned long chunk_count; /**< number of chunks to print boundaries of (0: print values) */
+	unsigned long chunk_align; /**< chunk sizes are multiples of this (default: 1) */
+	query_type query;       /**< question to answer instead of printing values */
+	unsigned long query_position; /**< position asked for by --nth, counting from 1 */
+	double query_value;     /**< value asked for by --index-of and --contains */
+	int aggregates;         /**< aggregates to print instead of values (see aggregate_flags) */
+	unsigned long reverse_count; /**< number of values to walk backwards through (with FLAG_REVERSE) */
+	char * verify_file;     /**< file to compare output against instead of printing (or NULL) */
+	struct _scaffolding * dimensions; /**< ranges to print the product of, each completed (or NULL) */
+	unsigned int dimension_count; /**< number of ranges in dimensions (0: single range) */
+	char * field_separator; /**< separation string between values of a tuple (default: tab) */
+	char ** field_formats;  /**< output format strings per range, given by --field-format */
+	unsigned int field_format_count; /**< number of entries in field_formats */
+	tuple_order order;      /**< order to print tuples of several ranges in (default: row-major) */
+	unsigned long tile_size; /**< number of values per tile and range (with ORDER_TILED) */
+	set_operation operation; /**< set operation on several ranges (default: none) */
+	double ratio;           /**< ratio given by --geometric, becoming the step (0: none) */
+	char * time_format;     /**< strftime-like format of timestamps (with FLAG_TIME) */
+	char * alphabet;        /**< characters to print values as words over (or NULL) */
+	unsigned long string_length; /**< characters per token of --random-string (0: none) */
+	char * string_alphabet; /**< characters to draw tokens from (with string_length) */
+	char * choice_file;     /**< file to pick random lines from (or NULL) */
+	char * weights_file;    /**< file of weights of lines of choice_file (or NULL) */
+	walk_type walk;         /**< kind of random walk given by --walk (default: none) */
+	quasi_sequence quasi;   /**< low-discrepancy sequence replacing random values (with FLAG_RANDOM) */
 } scaffolding;
 
 void complete_scaffold(scaffolding * scaffold);
-yield_status enum_yield(scaffolding * scaffold, float * dest);
+yield_status enum_yield(scaffolding * scaffold, double * dest);
+int count_values(scaffolding const * scaffold, unsigned long * dest);
+int count_window(scaffolding const * scaffold, unsigned long * dest);
+double value_at_position(scaffolding const * scaffold, unsigned long position);
+int position_of_value(scaffolding const * scaffold, double value, unsigned long * dest);
+int make_default_format_string(scaffolding * dest, unsigned int precision);
+void aggregate_window(scaffolding * scaffold, unsigned long window, aggregate_values * dest);
+void split_evenly(unsigned long total, unsigned long parts, unsigned long index,
+		unsigned long * offset, unsigned long * size);
 void initialize_scaffold(scaffolding * dest);
 
 #endif /* GENERATOR_H */
@@ -64,6 +64,8 @@ void dump_usage(FILE * file) {
 		"  enum [ OPTIONS ] LEFT RIGHT\n"
 		"  enum [ OPTIONS ] RIGHT\n"
 		"  ...\n"
+		"\n"
+		"  enum [ OPTIONS ] RANGE \",\" RANGE [ \",\" RANGE ... ]\n"
 		"\n");
 	fprintf(file,
 		"Options:\n"
@@ -85,7 +87,81 @@ void dump_usage(FILE * file) {
 	fprintf(file,
 		"  -r, --random          output random numbers, not sequential ones\n"
 		"  -i, --seed=NUMBER     specify seed for random number generator\n"
-		"\n"
+		"      --distribution=NAME[:ARGS]\n"
+		"                        draw from distribution uniform, normal,\n"
+		"                        exponential, lognormal or zipf\n"
+		"      --secure          use a cryptographically secure generator\n"
+		"      --quasi=NAME      spread values evenly like a sobol, halton\n"
+		"                        or vdc sequence rather than at random\n"
+		"\n");
+	fprintf(file,
+		"      --geometric=RATIO multiply by RATIO rather than add a step\n"
+		"      --log-spaced      space COUNT values between LEFT and RIGHT\n"
+		"                        evenly on a logarithmic scale\n"
+		"\n");
+	fprintf(file,
+		"      --time[=FORMAT]   take ISO 8601 instants and durations, print\n"
+		"                        timestamps in UTC (default: %%Y-%%m-%%dT%%H:%%M:%%SZ)\n"
+		"      --alphabet=CHARS  take and print words over CHARS like \"a-z\"\n"
+		"                        rather than numbers, e.g. aa to zz\n"
+		"      --primes          print only values that are primes\n"
+		"      --from-stdin      reformat numbers read from stdin rather\n"
+		"                        than printing a range\n");
+	fprintf(file,
+		"      --number-lines    prefix lines read from stdin with values\n"
+		"      --random-string=LENGTH\n"
+		"                        print random strings over --alphabet=CHARS\n"
+		"                        (default: 0-9A-Za-z), one for each value\n"
+		"      --choose-from=FILE\n"
+		"                        print random lines of FILE, one for each value\n"
+		"      --weights=FILE    pick lines in proportion to weights in FILE\n");
+	fprintf(file,
+		"      --walk[=KIND]     add a random step, uniform or normal increment\n"
+		"                        to the previous value, starting at LEFT and\n"
+		"                        staying up to RIGHT (default: step)\n"
+		"\n");
+	fprintf(file,
+		"      --skip=COUNT      leave out the first COUNT values\n"
+		"      --reverse         print the same values, last value first\n"
+		"      --limit=COUNT     print no more than COUNT values\n"
+		"      --shard=INDEX/COUNT\n"
+		"                        print slice INDEX out of COUNT slices\n"
+		"      --chunks=COUNT    print first value, last value and size of\n"
+		"                        COUNT chunks rather than all values\n"
+		"      --align=COUNT     make chunk sizes multiples of COUNT\n"
+		"\n");
+	fprintf(file,
+		"      --nth=POSITION    print the value at POSITION only\n"
+		"      --index-of=VALUE  print the position of VALUE only\n"
+		"      --contains=VALUE  print nothing, exit with 0 if VALUE is included\n"
+		"\n");
+	fprintf(file,
+		"      --sum, --count, --min, --max, --mean\n"
+		"                        print aggregates rather than values\n"
+		"      --predict-size    print number of values and bytes of output only\n"
+		"      --digest          print BLAKE3 hash of output only\n"
+		"      --verify=FILE     compare output with FILE, print nothing\n"
+		"\n");
+	fprintf(file,
+		"      --field-separator=TEXT\n"
+		"                        adjust separator between values of a tuple\n"
+		"                        of several ranges (default: tab)\n"
+		"      --field-format=FORMAT\n"
+		"                        adjust formatting of the next range\n");
+	fprintf(file,
+		"      --order=ORDER[:SIZE]\n"
+		"                        print tuples in order row, morton, hilbert\n"
+		"                        or tiled (with tiles of SIZE, default: 16)\n"
+		"      --zip             print several ranges side by side rather than\n"
+		"                        their product\n");
+	fprintf(file,
+		"      --concat          print several ranges one after another\n"
+		"      --union           print values of any range, in ascending order\n"
+		"      --intersection    print values of all ranges, in ascending order\n"
+		"      --except          leave the values of the range it starts out\n"
+		"                        of --union or --intersection\n"
+		"\n");
+	fprintf(file,
 		"  -w, --word=FORMAT     alias for --format\n"
 		"  -b, --dumb=TEXT       use verbatim text for values"
 		"\n");
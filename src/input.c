@@ -0,0 +1,393 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "input.h"
+
+#include <stdlib.h>  /* for malloc, strtod */
+#include <string.h>  /* for memmove, memcpy */
+#include <errno.h>   /* for errno, EINTR */
+#include <unistd.h>  /* for read, lseek, sysconf */
+#include <sys/stat.h>  /* for fstat */
+#ifdef HAVE_SYS_MMAN_H
+# include <sys/mman.h>  /* for mmap */
+#endif
+
+/** @name Classes of input bytes
+ *
+ * @since 1.2
+ */
+/*@{*/
+#define CLASS_DELIMITER  0
+#define CLASS_DIGIT      1
+#define CLASS_OTHER      2
+/*@}*/
+
+/** Largest number of significant digits parsed without strtod */
+#define FAST_DIGITS  15
+
+/** Number of bytes copied for strtod at most */
+#define SLOW_TOKEN_SIZE  512
+
+/** Powers of ten exactly representable as a double */
+static const double exact_powers_of_ten[] = {
+	1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+	1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+/** Class of each byte, filled on first use */
+static unsigned char byte_classes[256];
+static int byte_classes_ready = 0;
+
+/** Fill the table of byte classes
+ *
+ * Numbers are separated by white space, commas and semicolons.
+ *
+ * @since 1.2
+ */
+static void prepare_byte_classes(void) {
+	const char * const delimiters = " \t\n\v\f\r,;";
+	unsigned int c;
+
+	for (c = 0; c < 256; c++) {
+		byte_classes[c] = CLASS_OTHER;
+	}
+	for (c = '0'; c <= '9'; c++) {
+		byte_classes[c] = CLASS_DIGIT;
+	}
+	for (c = 0; delimiters[c] != '\0'; c++) {
+		byte_classes[(unsigned char)delimiters[c]] = CLASS_DELIMITER;
+	}
+	byte_classes_ready = 1;
+}
+
+/** Prepare reading from a file descriptor
+ *
+ * @param[out] reader
+ * @param[in] fd
+ * @param[in] capacity Number of bytes to buffer, e.g. INPUT_BLOCK_SIZE
+ *
+ * @return zero if out of memory, non-zero otherwise
+ *
+ * @since 1.2
+ */
+int input_init(input_reader * reader, int fd, size_t capacity) {
+	if (! byte_classes_ready) {
+		prepare_byte_classes();
+	}
+
+	reader->fd = fd;
+	reader->capacity = capacity;
+	reader->start = 0;
+	reader->end = 0;
+	reader->eof = 0;
+	reader->mapped = 0;
+	reader->token = NULL;
+	reader->token_length = 0;
+	reader->data = (char *)malloc(capacity);
+	return reader->data != NULL;
+}
+
+/** Map all of the input into memory at once, if it is a regular file
+ *
+ * Input starts at the current offset of the file descriptor, e.g. behind
+ * a line a shell has read already.  On success, the buffer is replaced by
+ * the mapping and end of input counts as reached.  Otherwise, the reader
+ * is left untouched and input is read block by block as usual.
+ *
+ * @param[in,out] reader Reader that has not read anything yet
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+int input_map(input_reader * reader) {
+#if defined(HAVE_MMAP) && defined(HAVE_SYS_MMAN_H)
+	struct stat properties;
+	off_t offset;
+	off_t aligned;
+	long page_size;
+	void * map;
+
+	if ((fstat(reader->fd, &properties) == -1) || ! S_ISREG(properties.st_mode)) {
+		return 0;
+	}
+
+	offset = lseek(reader->fd, 0, SEEK_CUR);
+	if ((offset == (off_t)-1) || (offset >= properties.st_size)) {
+		return 0;
+	}
+
+	/* Mappings start at page boundaries */
+	page_size = sysconf(_SC_PAGESIZE);
+	aligned = (page_size > 0) ? offset - offset % page_size : 0;
+
+	map = mmap(NULL, properties.st_size - aligned, PROT_READ, MAP_PRIVATE,
+		reader->fd, aligned);
+	if (map == MAP_FAILED) {
+		return 0;
+	}
+
+	free(reader->data);
+	reader->data = (char *)map;
+	reader->capacity = properties.st_size - aligned;
+	reader->start = offset - aligned;
+	reader->end = properties.st_size - aligned;
+	reader->eof = 1;
+	reader->mapped = 1;
+	return 1;
+#else
+	(void)reader;
+	return 0;
+#endif
+}
+
+/** Read more input behind the unconsumed bytes
+ *
+ * @param[in,out] reader
+ *
+ * @return number of bytes read, 0 at end of input or with a full
+ *         buffer, -1 on errors
+ *
+ * @since 1.2
+ */
+int input_refill(input_reader * reader) {
+	size_t unconsumed = reader->end - reader->start;
+
+	if (reader->eof) {
+		return 0;
+	}
+
+	if (reader->start > 0) {
+		memmove(reader->data, reader->data + reader->start, unconsumed);
+		reader->start = 0;
+		reader->end = unconsumed;
+	}
+
+	while (reader->end < reader->capacity) {
+		const ssize_t got = read(reader->fd, reader->data + reader->end,
+			reader->capacity - reader->end);
+		if (got < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return -1;
+		}
+		if (got == 0) {
+			reader->eof = 1;
+			break;
+		}
+		reader->end += (size_t)got;
+		break;
+	}
+
+	return (int)(reader->end - unconsumed);
+}
+
+/** Double the size of the buffer, e.g. for a record filling all of it
+ *
+ * @param[in,out] reader
+ *
+ * @return zero if out of memory, non-zero otherwise
+ *
+ * @since 1.2
+ */
+int input_grow(input_reader * reader) {
+	char * grown;
+
+	if (reader->mapped) {
+		return 1;
+	}
+
+	grown = (char *)realloc(reader->data, 2 * reader->capacity);
+	if (! grown) {
+		return 0;
+	}
+	reader->data = grown;
+	reader->capacity *= 2;
+	return 1;
+}
+
+/** Convert a token to a number
+ *
+ * Plain decimals of up to FAST_DIGITS significant digits are converted
+ * by hand: the digits form an exact integer that is divided by an exact
+ * power of ten, which rounds correctly.  Anything else goes to strtod.
+ *
+ * @param[in] token
+ * @param[in] length
+ * @param[out] value
+ * @param[out] precision Number of decimal places
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int convert_token(const char * token, size_t length, double * value,
+		unsigned int * precision) {
+	const char * walker = token;
+	const char * const stop = token + length;
+	double mantissa = 0;
+	unsigned int digits = 0;
+	unsigned int decimals = 0;
+	int negative = 0;
+	int seen_dot = 0;
+
+	if ((walker < stop) && ((*walker == '-') || (*walker == '+'))) {
+		negative = (*walker == '-');
+		walker++;
+	}
+
+	for (; walker < stop; walker++) {
+		if (byte_classes[(unsigned char)*walker] == CLASS_DIGIT) {
+			mantissa = mantissa * 10 + (*walker - '0');
+			digits++;
+			decimals += seen_dot;
+		} else if ((*walker == '.') && ! seen_dot) {
+			seen_dot = 1;
+		} else {
+			break;
+		}
+	}
+
+	if ((walker == stop) && (digits > 0) && (digits <= FAST_DIGITS)) {
+		*value = (negative ? -mantissa : mantissa) / exact_powers_of_ten[decimals];
+		*precision = decimals;
+		return 1;
+	}
+
+	/* Exponents, long mantissas and garbage */
+	{
+		char copy[SLOW_TOKEN_SIZE];
+		char * end;
+		const char * exponent;
+		long exponent_value = 0;
+
+		if (length >= sizeof(copy)) {
+			return 0;
+		}
+		memcpy(copy, token, length);
+		copy[length] = '\0';
+
+		*value = strtod(copy, &end);
+		if ((end != copy + length) || (digits == 0)
+				|| ((*walker != 'e') && (*walker != 'E') && (walker != stop))) {
+			return 0;
+		}
+
+		exponent = (walker < stop) ? copy + (walker - token) + 1 : NULL;
+		if (exponent) {
+			exponent_value = strtol(exponent, NULL, 10);
+		}
+		*precision = ((long)decimals > exponent_value)
+			? (unsigned int)((long)decimals - exponent_value)
+			: 0;
+		return 1;
+	}
+}
+
+/** Read the next number
+ *
+ * @param[in,out] reader
+ * @param[out] value
+ * @param[out] precision Number of decimal places given
+ *
+ * @return status
+ *
+ * @since 1.2
+ */
+input_status input_next_number(input_reader * reader, double * value,
+		unsigned int * precision) {
+	for (;;) {
+		const char * const data = reader->data;
+		size_t walker = reader->start;
+		size_t token_start;
+
+		/* Skip delimiters */
+		while ((walker < reader->end)
+				&& (byte_classes[(unsigned char)data[walker]] == CLASS_DELIMITER)) {
+			walker++;
+		}
+		token_start = walker;
+
+		/* Find end of token */
+		while ((walker < reader->end)
+				&& (byte_classes[(unsigned char)data[walker]] != CLASS_DELIMITER)) {
+			walker++;
+		}
+
+		if ((walker < reader->end) || (reader->eof && (walker > token_start))) {
+			reader->start = walker;
+			reader->token = data + token_start;
+			reader->token_length = walker - token_start;
+			return convert_token(reader->token, reader->token_length, value, precision)
+				? INPUT_NUMBER
+				: INPUT_INVALID;
+		}
+
+		/* Token may continue in the next block */
+		reader->start = token_start;
+		if (reader->eof) {
+			return INPUT_END;
+		}
+		if ((reader->start == 0) && (reader->end == reader->capacity)) {
+			return INPUT_TOO_LONG;
+		}
+		if (input_refill(reader) < 0) {
+			return INPUT_READ_ERROR;
+		}
+	}
+}
+
+/** Free memory held by a reader
+ *
+ * @param[in,out] reader
+ *
+ * @since 1.2
+ */
+void input_free(input_reader * reader) {
+#if defined(HAVE_MMAP) && defined(HAVE_SYS_MMAN_H)
+	if (reader->mapped) {
+		munmap(reader->data, reader->capacity);
+		reader->data = NULL;
+		return;
+	}
+#endif
+	free(reader->data);
+	reader->data = NULL;
+}
@@ -0,0 +1,97 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef INPUT_H
+#define INPUT_H 1
+
+#include <stddef.h>  /* for size_t */
+
+/** Number of bytes read from input at once
+ *
+ * @since 1.2
+ */
+#define INPUT_BLOCK_SIZE  (1024 * 1024)
+
+/** Largest number of decimal places kept from input
+ *
+ * @since 1.2
+ */
+#define INPUT_MAX_PRECISION  30
+
+/** Enumeration of possible return values of input_next_number()
+ *
+ * @since 1.2
+ */
+typedef enum _input_status {
+	INPUT_NUMBER,      /**< a number was read */
+	INPUT_END,         /**< end of input reached */
+	INPUT_INVALID,     /**< a token is not a number, see token */
+	INPUT_TOO_LONG,    /**< a token does not fit into the buffer */
+	INPUT_READ_ERROR   /**< reading failed, see errno */
+} input_status;
+
+/** State of reading input in large blocks
+ *
+ * Bytes are read with as few read(2) calls as possible into a single
+ * buffer.  Unconsumed bytes, e.g. a token cut off at the end of a block,
+ * are moved to the front before reading more.
+ *
+ * @since 1.2
+ */
+typedef struct _input_reader {
+	int fd;            /**< file descriptor to read from */
+	char * data;       /**< buffer */
+	size_t capacity;   /**< number of bytes allocated */
+	size_t start;      /**< offset of first unconsumed byte */
+	size_t end;        /**< offset past last byte read */
+	int eof;           /**< non-zero once end of input was reached */
+	int mapped;        /**< non-zero if data is mapped rather than allocated */
+	const char * token;  /**< last token found (with INPUT_INVALID) */
+	size_t token_length; /**< length of last token */
+} input_reader;
+
+int input_init(input_reader * reader, int fd, size_t capacity);
+int input_map(input_reader * reader);
+int input_refill(input_reader * reader);
+int input_grow(input_reader * reader);
+input_status input_next_number(input_reader * reader, double * value,
+		unsigned int * precision);
+void input_free(input_reader * reader);
+
+#endif /* INPUT_H */
@@ -43,54 +43,2029 @@
 #include "printing.h"
 #include "utils.h"
 #include "info.h"
+#include "random.h"
+#include "blake3.h"
+#include "timestamps.h"
+#include "alphabet.h"
+#include "primes.h"
+#include "input.h"
+#include "choice.h"
+#include "prediction.h"
+#include "ranges.h"
 
-#include <stdlib.h>  /* for srand */
+#include <stdlib.h>  /* for free */
+#include <string.h>  /* for strlen */
+#include <stdio.h>  /* for sprintf */
+#include <math.h>  /* for fabs */
 #include <time.h>  /* for time */
 #include <unistd.h>  /* for getpid */
+#include <limits.h>  /* for ULONG_MAX */
+#include <fcntl.h>  /* for open */
+#include <sys/stat.h>  /* for fstat */
+#include <errno.h>  /* for errno, EINTR */
+#ifdef HAVE_SYS_MMAN_H
+# include <sys/mman.h>  /* for mmap */
+#endif
+#ifdef HAVE_SYS_UIO_H
+# include <sys/uio.h>  /* for writev */
+#endif
+
+/** Number of records of --number-lines written at once
+ *
+ * @since 1.2
+ */
+#define NUMBERED_BATCH_SIZE  256
+
+/** Number of bytes of a record up to which --number-lines copies it
+ * rather than writing it in place
+ *
+ * @since 1.2
+ */
+#define NUMBERED_COPY_MAX  256
+
+/** Number of bytes of random strings drawn at once
+ *
+ * @since 1.2
+ */
+#define STRING_BATCH_SIZE  (64 * 1024)
+
+/** Number of pieces of output passed to writev at most, unless the
+ * system tells a larger number
+ *
+ * @since 1.2
+ */
+#ifdef IOV_MAX
+# define VECTOR_MAX  IOV_MAX
+#else
+# define VECTOR_MAX  16
+#endif
+
+/** Output expected by --verify=FILE
+ *
+ * @since 1.2
+ */
+typedef struct _expected_output {
+	char * data;     /**< content of file */
+	size_t size;     /**< number of bytes in file */
+	size_t offset;   /**< number of bytes matched so far */
+	int mapped;      /**< whether data is mapped rather than allocated */
+	int mismatch;    /**< whether output differs from data */
+} expected_output;
+
+/** Piece of output of --number-lines, either bytes of the text of a
+ * batch or a record kept in place
+ *
+ * @since 1.2
+ */
+typedef struct _numbered_piece {
+	const char * body;  /**< record inside input buffer (or NULL for text) */
+	size_t offset;      /**< offset into text of batch (without body) */
+	size_t length;      /**< number of bytes */
+} numbered_piece;
+
+/** Records collected by --number-lines before writing them at once
+ *
+ * Values and field separators are rendered into a single text, together
+ * with short records.  Longer records are not copied but point into the
+ * input buffer, which must not change before the batch is written.
+ *
+ * @since 1.2
+ */
+typedef struct _numbered_batch {
+	numbered_piece pieces[2 * NUMBERED_BATCH_SIZE];
+	unsigned int piece_count;       /**< number of pieces used */
+	unsigned int count;             /**< number of records added */
+	char * text;                    /**< rendered values and short records */
+	size_t text_length;             /**< number of bytes used in text */
+	size_t text_capacity;           /**< number of bytes allocated for text */
+	const char * field_separator;   /**< printed between value and record */
+	size_t field_separator_length;  /**< number of bytes of field_separator */
+	int direct;                     /**< whether to write to stdout with writev */
+	int vector_max;                 /**< number of pieces writev takes at most */
+} numbered_batch;
+
+/** Hash of output for --digest */
+static blake3_context digest_context;
+
+/** Output expected for --verify=FILE */
+static expected_output expected;
 
 /** Deep-frees memory behind a self-allocated argv-like structure
  *
- * @param[in] argc Number of entries in argv
- * @param[in,out] pargv Reference to argv-like structure to free
+ * @param[in] argc Number of entries in argv
+ * @param[in,out] pargv Reference to argv-like structure to free
+ *
+ * @since 0.5
+ */
+void free_malloced_argv(int argc, char *** pargv) {
+	int i = 0;
+	for (; i < argc; i++) {
+		free((*pargv)[i]);
+		(*pargv)[i] = NULL;
+	}
+	free(*pargv);
+	pargv = NULL;
+}
+
+/** Tells whether a piece of an argument starts with a count like "24x"
+ *
+ * @param[in] piece
+ *
+ * @return length of count including "x", zero if there is none
+ *
+ * @since 1.2
+ */
+static size_t count_prefix_length(const char * piece) {
+	const char * walker = piece;
+
+	while ((*walker >= '0') && (*walker <= '9')) {
+		walker++;
+	}
+	return ((walker > piece) && (*walker == 'x'))
+		? (size_t)(walker - piece) + 1
+		: 0;
+}
+
+/** Counts the non-empty pieces of arguments between ".." and white space
+ *
+ * @param[in] argc
+ * @param[in] argv
+ *
+ * @return number of pieces
+ *
+ * @since 1.2
+ */
+static unsigned int count_pieces(int argc, char ** argv) {
+	unsigned int pieces = 0;
+	int i;
+
+	for (i = 0; i < argc; i++) {
+		const char * walker = argv[i];
+
+		for (;;) {
+			const char * const dots = strstr(walker, "..");
+			if ((dots ? dots : walker + strlen(walker)) > walker) {
+				pieces++;
+			}
+			if (! dots) {
+				break;
+			}
+			walker = dots + 2;
+		}
+	}
+	return pieces;
+}
+
+/** Converts a piece of an argument to a number, if applicable
+ *
+ * With --time, ISO 8601 instants and durations become seconds.  With
+ * --alphabet=CHARS, words become their numbers, but only in place of
+ * LEFT or RIGHT so that STEP stays a plain number.
+ *
+ * @param[in] dest
+ * @param[in] piece
+ * @param[in] bound Whether the piece is in place of LEFT or RIGHT
+ * @param[out] value
+ * @param[out] too_large Set for words numbered beyond 2^53
+ *
+ * @return non-zero if converted, zero if to be kept as is
+ *
+ * @since 1.2
+ */
+static int convert_piece(scaffolding const * dest, const char * piece,
+		int bound, double * value, int * too_large) {
+	word_status status;
+
+	if (CHECK_FLAG(dest->flags, FLAG_TIME)) {
+		return parse_instant(piece, value) || parse_duration(piece, value);
+	}
+	if (! bound) {
+		return 0;
+	}
+	status = word_to_number(dest->alphabet, piece, value);
+	if (status == WORD_TOO_LARGE) {
+		*too_large = 1;
+	}
+	return status == WORD_SUCCESS;
+}
+
+/** Converts instants, durations or words in an argument to numbers
+ *
+ * For instance, with --time "2024-01-01..PT1H..2024-01-02" becomes
+ * "1704067200..3600..1704153600".  Counts like "24x" and plain numbers
+ * are kept as they are.
+ *
+ * @param[in] dest
+ * @param[in] argument
+ * @param[in,out] piece_index Index of the argument's first piece among all pieces
+ * @param[in] piece_count Number of pieces of all arguments
+ * @param[out] too_large Set for words numbered beyond 2^53
+ *
+ * @return converted argument, to be freed by the caller, or NULL if out
+ *         of memory or too_large is set
+ *
+ * @since 1.2
+ */
+static char * convert_argument(scaffolding const * dest, const char * argument,
+		unsigned int * piece_index, unsigned int piece_count, int * too_large) {
+	size_t pieces = 1;
+	const char * walker;
+	char * result;
+	char * write;
+
+	for (walker = argument; (walker = strstr(walker, "..")) != NULL; walker += 2) {
+		pieces++;
+	}
+
+	result = (char *)malloc(strlen(argument) + pieces * 32 + 1);
+	if (! result) {
+		return NULL;
+	}
+
+	write = result;
+	for (walker = argument;;) {
+		const char * const dots = strstr(walker, "..");
+		const size_t len = dots ? (size_t)(dots - walker) : strlen(walker);
+		char * const piece = enum_strndup(walker, len);
+		size_t prefix;
+		int bound;
+		double value;
+
+		if (! piece) {
+			free(result);
+			return NULL;
+		}
+
+		/* Keep count prefix "Nx"; a middle piece of three is STEP */
+		prefix = count_prefix_length(piece);
+		bound = (prefix == 0) && ! ((piece_count == 3) && (*piece_index == 1));
+		memcpy(write, piece, prefix);
+		write += prefix;
+
+		if (convert_piece(dest, piece + prefix, bound, &value, too_large)) {
+			write += sprintf(write, "%.0f", value);
+		} else {
+			strcpy(write, piece + prefix);
+			write += len - prefix;
+		}
+		if (len > 0) {
+			(*piece_index)++;
+		}
+		free(piece);
+
+		if (*too_large) {
+			free(result);
+			return NULL;
+		}
+
+		if (! dots) {
+			break;
+		}
+		memcpy(write, "..", 2);
+		write += 2;
+		walker = dots + 2;
+	}
+	*write = '\0';
+
+	return result;
+}
+
+/** Parses the arguments of a single range into scaffold
+ *
+ * With --time or --alphabet=CHARS, instants, durations or words are
+ * converted to numbers first.
+ *
+ * @param[in] reduced_argc
+ * @param[in] reduced_argv
+ * @param[out] dest
+ *
+ * @return zero in case of failure, non-zero otherwise
+ *
+ * @since 1.2
+ */
+static int parse_range(int reduced_argc, char ** reduced_argv, scaffolding * dest) {
+	int newargc;
+	char ** newargv;
+	char ** converted_argv = NULL;
+	int success;
+
+	if (CHECK_FLAG(dest->flags, FLAG_TIME) || dest->alphabet) {
+		const unsigned int piece_count = count_pieces(reduced_argc, reduced_argv);
+		unsigned int piece_index = 0;
+		int too_large = 0;
+		int i;
+
+		converted_argv = (char **)malloc((reduced_argc + 1) * sizeof(char *));
+		if (! converted_argv) {
+			print_problem(OUTOFMEM_ERROR);
+			return 0;
+		}
+		for (i = 0; i < reduced_argc; i++) {
+			converted_argv[i] = convert_argument(dest, reduced_argv[i],
+				&piece_index, piece_count, &too_large);
+			if (! converted_argv[i]) {
+				free_malloced_argv(i, &converted_argv);
+				if (too_large) {
+					print_problem(USER_ERROR, "Words numbered beyond 2^53 not supported.");
+				} else {
+					print_problem(OUTOFMEM_ERROR);
+				}
+				return 0;
+			}
+		}
+		reduced_argv = converted_argv;
+	}
+
+	success = preparse_args(reduced_argc, reduced_argv, &newargc, &newargv);
+	if (converted_argv) {
+		free_malloced_argv(reduced_argc, &converted_argv);
+	}
+	if (! success) {
+		free_malloced_argv(newargc, &newargv);
+		return 0;
+	}
+
+	success = parse_args(newargc, newargv, dest);
+	free_malloced_argv(newargc, &newargv);
+	return success;
+}
+
+/** Parses arguments into a single range or several ranges
+ *
+ * Ranges are separated by commas, e.g. "enum 1 3 , 1 2".  A single
+ * range is stored to dest itself.  Several ranges are stored to
+ * dest->dimensions, each inheriting precision and equal width from dest.
+ * Each of several ranges may start with -r|--random to draw random
+ * values, inheriting the kind of generator and distribution from dest.
+ *
+ * @param[in] reduced_argc
+ * @param[in] reduced_argv
+ * @param[in,out] dest
+ *
+ * @return zero in case of failure, non-zero otherwise
+ *
+ * @since 1.2
+ */
+static int parse_ranges(int reduced_argc, char ** reduced_argv, scaffolding * dest) {
+	unsigned int count = 1;
+	int start = 0;
+	int i;
+	int split_argc;
+	char ** split_argv;
+	int success = 1;
+
+	/* Commas attached to ranges are for --concat only */
+	if (! split_at_commas(reduced_argc, reduced_argv, CHECK_FLAG(dest->flags, FLAG_CONCAT),
+			&split_argc, &split_argv)) {
+		free_malloced_argv(split_argc, &split_argv);
+		print_problem(OUTOFMEM_ERROR);
+		return 0;
+	}
+
+	for (i = 0; i < split_argc; i++) {
+		if (! strcmp(split_argv[i], ",")) {
+			count++;
+		}
+	}
+
+	if ((count > 1) && (CHECK_FLAG(dest->flags, FLAG_TIME) || dest->alphabet)) {
+		free_malloced_argv(split_argc, &split_argv);
+		print_problem(USER_ERROR, "Combining several ranges and --time or --alphabet=CHARS not supported.");
+		return 0;
+	}
+
+	if (count == 1) {
+		/* Low-discrepancy values take the place of random values */
+		if (dest->quasi.type != QUASI_NONE) {
+			dest->flags |= FLAG_RANDOM;
+			quasi_init(&(dest->quasi), dest->quasi.type, 0);
+		}
+		success = parse_range(split_argc, split_argv, dest);
+		free_malloced_argv(split_argc, &split_argv);
+		return success;
+	}
+
+	dest->dimensions = (scaffolding *)malloc(count * sizeof(scaffolding));
+	if (! dest->dimensions) {
+		free_malloced_argv(split_argc, &split_argv);
+		print_problem(OUTOFMEM_ERROR);
+		return 0;
+	}
+
+	for (i = 0; (i <= split_argc) && success; i++) {
+		scaffolding * range;
+
+		if ((i < split_argc) && strcmp(split_argv[i], ",")) {
+			continue;
+		}
+
+		range = dest->dimensions + dest->dimension_count;
+		initialize_scaffold(range);
+		range->flags = dest->flags & (FLAG_USER_PRECISION | FLAG_EQUAL_WIDTH);
+		range->user_precision = dest->user_precision;
+		dest->dimension_count++;
+
+		/* Values to leave out of a set operation? */
+		if ((start < i) && ! strcmp(split_argv[start], "--except")) {
+			range->flags |= FLAG_EXCEPT;
+			start++;
+		}
+
+		/* One dimension of a low-discrepancy sequence per range */
+		if (dest->quasi.type != QUASI_NONE) {
+			range->flags |= FLAG_RANDOM;
+			if (! quasi_init(&(range->quasi), dest->quasi.type, dest->dimension_count - 1)) {
+				if (dest->quasi.type == QUASI_VDC) {
+					print_problem(USER_ERROR, "Combining several ranges and --quasi=vdc not supported.");
+				} else {
+					print_problem(USER_ERROR, "Combining more than %d ranges and --quasi=NAME not supported.",
+						QUASI_MAX_DIMENSIONS);
+				}
+				success = 0;
+				break;
+			}
+		}
+
+		/* Random values for this range only? */
+		if ((start < i) && is_random_range_marker(split_argv[start])) {
+			unsigned int j;
+
+			range->flags |= FLAG_RANDOM | (dest->flags & FLAG_SECURE);
+			range->distribution = dest->distribution;
+			range->distribution_argc = dest->distribution_argc;
+			for (j = 0; j < dest->distribution_argc; j++) {
+				range->distribution_args[j] = dest->distribution_args[j];
+			}
+			start++;
+		}
+
+		success = parse_range(i - start, split_argv + start, range);
+		start = i + 1;
+	}
+
+	free_malloced_argv(split_argc, &split_argv);
+	return success;
+}
+
+/** Prints the separator to be put between two values
+ *
+ * @param[in] dest Scaffolding to work with
+ *
+ * @since 1.2
+ */
+static void print_separator(scaffolding const * dest) {
+	if (CHECK_FLAG(dest->flags, FLAG_NULL_BYTES)) {
+		output_bytes("", 1);
+	} else {
+		output_bytes(dest->separator, strlen(dest->separator));
+	}
+}
+
+/** Tells whether output is the last part of the complete output
+ *
+ * Only the last of several shards ends with the terminator, so that
+ * concatenating all shards makes up the unsharded output.
+ *
+ * @param[in] dest Scaffolding to work with
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int is_last_shard(scaffolding const * dest) {
+	return dest->shard_index == dest->shard_count;
+}
+
+/** Prints boundaries of chunks instead of values
+ *
+ * The values selected are split into dest->chunk_count contiguous chunks
+ * of balanced size, each a multiple of dest->chunk_align values long
+ * except for the last one.  For each non-empty chunk, its first value,
+ * its last value and the number of values are printed.
+ *
+ * @param[in] dest Scaffolding to work with
+ * @param[in] window Number of values selected
+ *
+ * @since 1.2
+ */
+static void print_chunks(scaffolding const * dest, unsigned long window) {
+	const unsigned long blocks = window / dest->chunk_align
+		+ ((window % dest->chunk_align) ? 1 : 0);
+	unsigned long i;
+	int printed = 0;
+
+	for (i = 0; i < dest->chunk_count; i++) {
+		unsigned long offset;
+		unsigned long size;
+
+		split_evenly(blocks, dest->chunk_count, i, &offset, &size);
+		if (size == 0) {
+			continue;
+		}
+		offset *= dest->chunk_align;
+		size = ENUM_MIN(size * dest->chunk_align, window - offset);
+
+		if (printed) {
+			print_separator(dest);
+		}
+		multi_printf(dest->format, value_at_position(dest, dest->skip + offset));
+		printf(" ");
+		multi_printf(dest->format, value_at_position(dest, dest->skip + offset + size - 1));
+		printf(" %lu", size);
+		printed = 1;
+	}
+}
+
+/** Frees memory allocated for formats, separators and terminator
+ *
+ * @param[in,out] dest Scaffolding to work with
+ *
+ * @since 1.2
+ */
+static void release_output(scaffolding * dest) {
+	unsigned int i;
+
+	free(dest->terminator);
+	free(dest->format);
+	free(dest->separator);
+	free(dest->verify_file);
+	free(dest->time_format);
+	free(dest->alphabet);
+	free(dest->string_alphabet);
+	free(dest->choice_file);
+	free(dest->weights_file);
+
+	for (i = 0; i < dest->dimension_count; i++) {
+		free(dest->dimensions[i].format);
+	}
+	free(dest->dimensions);
+	for (i = 0; i < dest->field_format_count; i++) {
+		free(dest->field_formats[i]);
+	}
+	free(dest->field_formats);
+	free(dest->field_separator);
+}
+
+/** Prints number of values and bytes instead of the values
+ *
+ * Bytes include separators and the terminator, i.e. they match the size
+ * of the output of the same command without --predict-size.
+ *
+ * @param[in,out] dest Scaffolding to work with
+ * @param[in] window Number of values selected
+ *
+ * @since 1.2
+ */
+static void print_size_prediction(scaffolding * dest, unsigned long window) {
+	const size_t separator_length = CHECK_FLAG(dest->flags, FLAG_NULL_BYTES)
+		? 1
+		: strlen(dest->separator);
+	double bytes = count_value_bytes(dest, window);
+
+	if (window > 0) {
+		bytes += (double)(window - 1) * separator_length;
+	}
+
+	if (! is_last_shard(dest)) {
+		if (window > 0) {
+			bytes += separator_length;
+		}
+	} else {
+		bytes += dest->terminator ? strlen(dest->terminator) : 1;
+	}
+
+	printf("%lu %.0f\n", window, bytes);
+	release_output(dest);
+}
+
+/** Prints the terminator to be put after the last value
+ *
+ * @param[in] dest Scaffolding to work with
+ *
+ * @since 1.2
+ */
+static void print_terminator(scaffolding const * dest) {
+	if (! is_last_shard(dest)) {
+		/* No terminator in between shards */
+	} else if (dest->terminator) {
+		output_bytes(dest->terminator, strlen(dest->terminator));
+	} else {
+		output_bytes("\n", 1);
+	}
+}
+
+/** Prints terminator, frees allocated memory
+ *
+ * @param[in,out] dest Scaffolding to work with
+ *
+ * @since 1.1
+ */
+static void finalize_output(scaffolding * dest) {
+	print_terminator(dest);
+	release_output(dest);
+}
+
+/** Output sink adding output to the hash for --digest
+ *
+ * @param[in] data
+ * @param[in] length Number of bytes
+ *
+ * @return 1, i.e. all output is wanted
+ *
+ * @since 1.2
+ */
+static int digest_sink(const char * data, size_t length) {
+	blake3_update(&digest_context, (const unsigned char *)data, length);
+	return 1;
+}
+
+/** Output sink comparing output with the file given by --verify=FILE
+ *
+ * Blocks are compared with memcmp, which common C libraries vectorize;
+ * only a block known to differ is searched for the first differing byte.
+ *
+ * @param[in] data
+ * @param[in] length Number of bytes
+ *
+ * @return 1 while output matches, 0 after the first mismatch
+ *
+ * @since 1.2
+ */
+static int verify_sink(const char * data, size_t length) {
+	const char * const file_data = expected.data + expected.offset;
+	const size_t common = ENUM_MIN(length, expected.size - expected.offset);
+
+	if ((common > 0) && (memcmp(data, file_data, common) != 0)) {
+		size_t i = 0;
+		while (data[i] == file_data[i]) {
+			i++;
+		}
+		expected.offset += i;
+		expected.mismatch = 1;
+		return 0;
+	}
+
+	expected.offset += common;
+	if (common < length) {
+		/* Output goes beyond the end of the file */
+		expected.mismatch = 1;
+		return 0;
+	}
+	return 1;
+}
+
+/** Loads the file given by --verify=FILE
+ *
+ * Regular files are mapped into memory where supported, anything else
+ * (e.g. pipes) is read in full.
+ *
+ * @param[in] filename
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int load_expected_output(const char * filename) {
+	struct stat properties;
+	size_t capacity = 0;
+	const int fd = open(filename, O_RDONLY);
+
+	expected.data = NULL;
+	expected.size = 0;
+	expected.offset = 0;
+	expected.mapped = 0;
+	expected.mismatch = 0;
+
+	if (fd == -1) {
+		return 0;
+	}
+
+	if (fstat(fd, &properties) == -1) {
+		close(fd);
+		return 0;
+	}
+
+#if defined(HAVE_MMAP) && defined(HAVE_SYS_MMAN_H)
+	if (S_ISREG(properties.st_mode) && (properties.st_size > 0)) {
+		void * const map = mmap(NULL, properties.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (map != MAP_FAILED) {
+			expected.data = (char *)map;
+			expected.size = properties.st_size;
+			expected.mapped = 1;
+			close(fd);
+			return 1;
+		}
+	}
+#endif
+
+	while (1) {
+		ssize_t bytes_read;
+
+		if (expected.size == capacity) {
+			char * const data = (char *)realloc(expected.data,
+				capacity ? 2 * capacity : 64 * 1024);
+			if (! data) {
+				free(expected.data);
+				close(fd);
+				return 0;
+			}
+			expected.data = data;
+			capacity = capacity ? 2 * capacity : 64 * 1024;
+		}
+
+		bytes_read = read(fd, expected.data + expected.size, capacity - expected.size);
+		if (bytes_read == 0) {
+			break;
+		} else if (bytes_read < 0) {
+			free(expected.data);
+			close(fd);
+			return 0;
+		}
+		expected.size += bytes_read;
+	}
+
+	close(fd);
+	return 1;
+}
+
+/** Frees memory behind the content of the file given by --verify=FILE
+ *
+ * @since 1.2
+ */
+static void release_expected_output(void) {
+#if defined(HAVE_MMAP) && defined(HAVE_SYS_MMAN_H)
+	if (expected.mapped) {
+		munmap(expected.data, expected.size);
+		return;
+	}
+#endif
+	free(expected.data);
+}
+
+/** Prints terminator, reports digest or verification, frees allocated memory
+ *
+ * With --digest, the BLAKE3 hash of the output is printed in hex
+ * instead of the output.  With --verify=FILE, nothing is printed
+ * unless the output differs from the file.
+ *
+ * @param[in,out] dest Scaffolding to work with
+ *
+ * @return exit code, i.e. 0 on success and 1 for differing output
+ *
+ * @since 1.2
+ */
+static int conclude_output(scaffolding * dest) {
+	int ret = 0;
+
+	print_terminator(dest);
+	set_output_sink(NULL);
+
+	if (CHECK_FLAG(dest->flags, FLAG_DIGEST)) {
+		unsigned char digest[BLAKE3_OUT_LEN];
+		int i;
+
+		blake3_final(&digest_context, digest);
+		for (i = 0; i < BLAKE3_OUT_LEN; i++) {
+			printf("%02x", digest[i]);
+		}
+		printf("\n");
+	} else if (dest->verify_file) {
+		if (expected.mismatch || (expected.offset != expected.size)) {
+			print_problem(ERROR, "Output differs from file \"%s\" at byte offset %lu.",
+				dest->verify_file, (unsigned long)expected.offset);
+			ret = 1;
+		}
+		release_expected_output();
+	}
+
+	release_output(dest);
+	return ret;
+}
+
+/** Prints aggregates of the values selected instead of the values
+ *
+ * Aggregates are printed in order sum, count, minimum, maximum and mean.
+ * Sum, minimum and maximum are printed with the number of decimal places
+ * of the values rather than through the output format, as they need not
+ * fit into what the format converts to.
+ *
+ * @param[in,out] dest Scaffolding to work with
+ * @param[in] window Number of values selected
+ *
+ * @return exit code, i.e. 0 on success and 1 for undefined aggregates
+ *
+ * @since 1.2
+ */
+static int print_aggregates(scaffolding * dest, unsigned long window) {
+	const int precision = (int)(CHECK_FLAG(dest->flags, FLAG_USER_PRECISION)
+		? dest->user_precision
+		: dest->auto_precision);
+	aggregate_values aggregates;
+	int printed = 0;
+
+	if ((window == 0) && (dest->aggregates
+			& (AGGREGATE_MIN | AGGREGATE_MAX | AGGREGATE_MEAN))) {
+		print_problem(ERROR, "Minimum, maximum and mean of no values are undefined.");
+		return 1;
+	}
+
+	aggregate_window(dest, window, &aggregates);
+
+	if (CHECK_FLAG(dest->aggregates, AGGREGATE_SUM)) {
+		if (aggregates.exact_sum[0] != '\0') {
+			printf("%s", aggregates.exact_sum);
+			if (precision > 0) {
+				printf(".%0*d", precision, 0);
+			}
+		} else if (fabs(aggregates.sum) > PROGRESSION_MAX_EXACT) {
+			/* Fixed notation would invent digits beyond 2^53 */
+			printf("%.17g", aggregates.sum);
+		} else {
+			printf("%.*f", precision, aggregates.sum);
+		}
+		printed = 1;
+	}
+	if (CHECK_FLAG(dest->aggregates, AGGREGATE_COUNT)) {
+		if (printed) {
+			print_separator(dest);
+		}
+		printf("%lu", window);
+		printed = 1;
+	}
+	if (CHECK_FLAG(dest->aggregates, AGGREGATE_MIN)) {
+		if (printed) {
+			print_separator(dest);
+		}
+		printf("%.*f", precision, aggregates.min);
+		printed = 1;
+	}
+	if (CHECK_FLAG(dest->aggregates, AGGREGATE_MAX)) {
+		if (printed) {
+			print_separator(dest);
+		}
+		printf("%.*f", precision, aggregates.max);
+		printed = 1;
+	}
+	if (CHECK_FLAG(dest->aggregates, AGGREGATE_MEAN)) {
+		if (printed) {
+			print_separator(dest);
+		}
+		/* The mean may need one more decimal place than the values */
+		if (CHECK_FLAG(dest->flags, FLAG_USER_PRECISION)) {
+			printf("%.*f", (int)dest->user_precision, aggregates.sum / window);
+		} else {
+			printf("%.15g", aggregates.sum / window);
+		}
+	}
+
+	finalize_output(dest);
+	return 0;
+}
+
+/** Answers the query given by --nth, --index-of or --contains
+ *
+ * Positions are counted from 1 and relative to the values selected by
+ * --skip and --limit.
+ *
+ * @param[in,out] dest Scaffolding to work with
+ *
+ * @return exit code, i.e. 0 on success and 1 for missing values
+ *
+ * @since 1.2
+ */
+static int answer_query(scaffolding * dest) {
+	unsigned long window;
+	unsigned long position;
+	const int finite = count_window(dest, &window);
+	int found;
+
+	if (dest->query == QUERY_NTH) {
+		found = ! finite || (dest->query_position <= window);
+		if (found) {
+			multi_printf(dest->format, value_at_position(dest,
+				dest->skip + dest->query_position - 1));
+		} else {
+			print_problem(ERROR, "Position %lu is beyond the last value.",
+				dest->query_position);
+		}
+	} else {
+		found = position_of_value(dest, dest->query_value, &position)
+			&& (position >= dest->skip)
+			&& (! finite || (position - dest->skip < window));
+		if (found && (dest->query == QUERY_INDEX_OF)) {
+			printf("%lu", position - dest->skip + 1);
+		}
+	}
+
+	if (found && (dest->query != QUERY_CONTAINS)) {
+		finalize_output(dest);
+	} else {
+		release_output(dest);
+	}
+
+	return found ? 0 : 1;
+}
+
+/** Installs the output sink for --digest or --verify=FILE, if given
+ *
+ * @param[in,out] dest Scaffolding to work with
+ * @param[in] finite Whether output is known to end
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int start_output(scaffolding * dest, int finite) {
+	if (CHECK_FLAG(dest->flags, FLAG_DIGEST)) {
+		if (! finite) {
+			print_problem(USER_ERROR, "Combining --digest and infinity not supported.");
+			return 0;
+		}
+		blake3_init(&digest_context);
+		set_output_sink(digest_sink);
+	} else if (dest->verify_file) {
+		if (! load_expected_output(dest->verify_file)) {
+			print_problem(ERROR, "Could not read file \"%s\".", dest->verify_file);
+			release_output(dest);
+			return 0;
+		}
+		set_output_sink(verify_sink);
+	}
+	return 1;
+}
+
+/** Seeds the random number generator
+ *
+ * @param[in] dest Scaffolding to work with
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int seed_random(scaffolding const * dest) {
+	if (CHECK_FLAG(dest->flags, FLAG_SECURE)) {
+		if (! enum_random_secure()) {
+			print_problem(ERROR, "Could not obtain entropy from the operating system.");
+			return 0;
+		}
+	} else {
+		unsigned int const seed = CHECK_FLAG(dest->flags, FLAG_USER_SEED)
+			? dest->seed
+			: (unsigned int)(time(NULL) + getpid());
+		enum_random_seed(seed);
+	}
+	return 1;
+}
+
+/** Prepares a single range for --geometric=RATIO or --log-spaced
+ *
+ * The ratio given by --geometric=RATIO takes the place of the step.
+ * With --log-spaced, the ratio is derived from LEFT, COUNT and RIGHT.
+ *
+ * @param[in,out] dest Scaffolding to work with
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int prepare_geometric(scaffolding * dest) {
+	if (! CHECK_FLAG(dest->flags, FLAG_GEOMETRIC)) {
+		return 1;
+	}
+
+	if (HAS_STEP(dest)) {
+		print_problem(USER_ERROR, "Combining --geometric=RATIO or --log-spaced and STEP not supported.");
+		return 0;
+	}
+
+	if (dest->ratio != 0) {
+		SET_STEP(*dest, dest->ratio);
+		dest->flags |= FLAG_USER_STEP;
+	} else if (! HAS_LEFT(dest) || ! HAS_COUNT(dest) || ! HAS_RIGHT(dest)) {
+		print_problem(USER_ERROR, "Parameter --log-spaced requires LEFT, COUNT and RIGHT.");
+		return 0;
+	} else if ((dest->left == dest->right) && (dest->count > 1)) {
+		print_problem(USER_ERROR, "Parameter --log-spaced requires LEFT and RIGHT to differ unless COUNT is 1.");
+		return 0;
+	}
+
+	if ((HAS_LEFT(dest) && (dest->left == 0))
+			|| (HAS_RIGHT(dest) && (dest->right == 0))
+			|| (HAS_LEFT(dest) && HAS_RIGHT(dest) && ((dest->left < 0) != (dest->right < 0)))) {
+		print_problem(USER_ERROR, "Combining --geometric=RATIO or --log-spaced and zero or bounds of different sign not supported.");
+		return 0;
+	}
+	return 1;
+}
+
+/** Tells whether a completed range stays with numbers of words
+ *
+ * Words over an alphabet are numbered from 1, so values must be whole
+ * numbers of 1 and above.  Random values are rounded when printed.
+ *
+ * @param[in] dest
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int is_word_range(scaffolding const * dest) {
+	if ((dest->left < 1) || (HAS_RIGHT(dest) && (dest->right < 1))) {
+		return 0;
+	}
+	if (CHECK_FLAG(dest->flags, FLAG_RANDOM)) {
+		return 1;
+	}
+	return (floor(dest->left) == dest->left) && (floor(dest->step) == dest->step)
+		&& (HAS_RIGHT(dest) || (dest->step >= 0));
+}
+
+/** Sets separators not given by the user to their defaults
+ *
+ * @param[in,out] dest Scaffolding to work with
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int set_default_separators(scaffolding * dest) {
+	if (! dest->separator) {
+		dest->separator = enum_strdup("\n");
+		if (! dest->separator) {
+			print_problem(OUTOFMEM_ERROR);
+			return 0;
+		}
+	}
+
+	if (! dest->field_separator) {
+		dest->field_separator = enum_strdup("\t");
+		if (! dest->field_separator) {
+			print_problem(OUTOFMEM_ERROR);
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/** Reports a problem with several ranges
+ *
+ * @param[in] status Problem to report
+ *
+ * @since 1.2
+ */
+static void report_ranges_problem(ranges_status status) {
+	switch (status) {
+	case RANGES_SINGLE_RANGE_OPTION:
+		print_problem(USER_ERROR, "Combining several ranges and -r|--random, --skip, --reverse, --shard, --chunks, queries, aggregates or --predict-size not supported.");
+		break;
+	case RANGES_CONCAT_OPTION:
+		print_problem(USER_ERROR, "Combining --concat and --zip, --order=ORDER, --field-separator=TEXT or --field-format=FORMAT not supported.");
+		break;
+	case RANGES_SET_OPTION:
+		print_problem(USER_ERROR, "Combining --union or --intersection and --zip, --concat, --order=ORDER, --field-separator=TEXT or --field-format=FORMAT not supported.");
+		break;
+	case RANGES_SEQUENCE_OPTION:
+		print_problem(USER_ERROR, "Combining several ranges and --geometric=RATIO, --log-spaced, --primes, --number-lines, --random-string=LENGTH, --choose-from=FILE or --walk[=KIND] not supported.");
+		break;
+	case RANGES_ZIP_ORDER:
+		print_problem(USER_ERROR, "Combining --zip and --order=ORDER not supported.");
+		break;
+	case RANGES_TOO_MANY_FORMATS:
+		print_problem(USER_ERROR, "More formats given by --field-format=FORMAT than ranges.");
+		break;
+	case RANGES_EXCEPT_WITHOUT_SET:
+		print_problem(USER_ERROR, "Ranges marked --except require --union or --intersection.");
+		break;
+	case RANGES_SET_RANDOM:
+		print_problem(USER_ERROR, "Combining --union or --intersection and random values not supported.");
+		break;
+	case RANGES_RANDOM_WITHOUT_ZIP:
+		print_problem(USER_ERROR, "Random values in one of several ranges require --zip or --concat.");
+		break;
+	case RANGES_INNER_INFINITY:
+		print_problem(USER_ERROR, "Combining infinity and ranges other than the first not supported.");
+		break;
+	case RANGES_SET_DESCENDING_INFINITY:
+		print_problem(USER_ERROR, "Combining --union or --intersection and infinity in descending ranges not supported.");
+		break;
+	case RANGES_SET_NOT_INTEGERS:
+		print_problem(USER_ERROR, "Combining --union or --intersection and values other than integers up to 2^53 not supported.");
+		break;
+	case RANGES_CONCAT_INFINITY:
+		print_problem(USER_ERROR, "Combining --concat and infinity in ranges other than the last not supported.");
+		break;
+	case RANGES_ORDER_INFINITY:
+		print_problem(USER_ERROR, "Combining --order=ORDER and infinity not supported.");
+		break;
+	case RANGES_EQUAL_WIDTH_INFINITY:
+		print_problem(USER_ERROR, "Combining -e|--equal-width and infinity not supported.");
+		break;
+	case RANGES_TOO_LARGE:
+		print_problem(USER_ERROR, "Ranges too large for --order=ORDER.");
+		break;
+	default:
+		print_problem(OUTOFMEM_ERROR);
+		break;
+	}
+}
+
+/** Prints the Cartesian product of several ranges
+ *
+ * Tuples are printed in the order given by --order, see
+ * range_product_init().  The text of each value is kept across tuples,
+ * so only ranges that advanced are rendered again.
+ *
+ * @param[in,out] dest Scaffolding to work with
+ *
+ * @return exit code, i.e. 0 on success and 1 on errors
+ *
+ * @since 1.2
+ */
+static int print_product(scaffolding * dest) {
+	const unsigned int dimension_count = dest->dimension_count;
+	unsigned long * const rendered = (unsigned long *)malloc(dimension_count * sizeof(unsigned long));
+	text_buffer * const texts = (text_buffer *)calloc(dimension_count, sizeof(text_buffer));
+	const size_t field_separator_length = strlen(dest->field_separator);
+	range_product product;
+	ranges_status status;
+	unsigned long printed = 0;
+	unsigned int i;
+
+	if (! rendered || ! texts) {
+		free(rendered);
+		free(texts);
+		print_problem(OUTOFMEM_ERROR);
+		return 1;
+	}
+
+	status = range_product_init(&product, dest);
+	if ((status != RANGES_SUCCESS) || ! start_output(dest, product.finite)) {
+		if (status != RANGES_SUCCESS) {
+			report_ranges_problem(status);
+		}
+		range_product_free(&product);
+		free(rendered);
+		free(texts);
+		return 1;
+	}
+
+	for (i = 0; (i < dimension_count) && ! product.done; i++) {
+		rendered[i] = product.walk.positions[i];
+		multi_printf_text(dest->dimensions[i].format,
+			range_product_value(&product, i), texts + i);
+	}
+
+	while (! product.done) {
+		if (printed > 0) {
+			print_separator(dest);
+		}
+		for (i = 0; i < dimension_count; i++) {
+			if (i > 0) {
+				output_bytes(dest->field_separator, field_separator_length);
+			}
+			output_bytes(texts[i].data, texts[i].length);
+		}
+		printed++;
+
+		if (is_output_stopped() || ! range_product_next(&product)) {
+			break;
+		}
+
+		for (i = 0; i < dimension_count; i++) {
+			if (product.walk.positions[i] != rendered[i]) {
+				rendered[i] = product.walk.positions[i];
+				multi_printf_text(dest->dimensions[i].format,
+					range_product_value(&product, i), texts + i);
+			}
+		}
+	}
+
+	range_product_free(&product);
+	for (i = 0; i < dimension_count; i++) {
+		free(texts[i].data);
+	}
+	free(rendered);
+	free(texts);
+
+	return conclude_output(dest);
+}
+
+/** Prints several ranges side by side
+ *
+ * Each row holds the next value of every range, until the shortest
+ * range ends.
+ *
+ * @param[in,out] dest Scaffolding to work with
+ *
+ * @return exit code, i.e. 0 on success and 1 on errors
+ *
+ * @since 1.2
+ */
+static int print_zip(scaffolding * dest) {
+	const size_t field_separator_length = strlen(dest->field_separator);
+	double * const values = (double *)malloc(dest->dimension_count * sizeof(double));
+	range_zip zip;
+	unsigned long printed = 0;
+	unsigned int i;
+
+	if (! values) {
+		print_problem(OUTOFMEM_ERROR);
+		return 1;
+	}
+
+	range_zip_init(&zip, dest);
+	if ((zip.random && ! seed_random(dest)) || ! start_output(dest, zip.finite)) {
+		free(values);
+		return 1;
+	}
+
+	while (range_zip_next(&zip, values)) {
+		if (printed > 0) {
+			print_separator(dest);
+		}
+		for (i = 0; i < dest->dimension_count; i++) {
+			if (i > 0) {
+				output_bytes(dest->field_separator, field_separator_length);
+			}
+			multi_printf(dest->dimensions[i].format, values[i]);
+		}
+		printed++;
+
+		if (is_output_stopped()) {
+			break;
+		}
+	}
+
+	free(values);
+	return conclude_output(dest);
+}
+
+/** Prints several ranges one after another
+ *
+ * Values of all ranges share a single separator, terminator and
+ * --limit=COUNT, as if they came from a single range.
+ *
+ * @param[in,out] dest Scaffolding to work with
+ *
+ * @return exit code, i.e. 0 on success and 1 on errors
+ *
+ * @since 1.2
+ */
+static int print_concat(scaffolding * dest) {
+	range_concat concat;
+	unsigned long printed = 0;
+	double value;
+	unsigned int index;
+
+	range_concat_init(&concat, dest);
+	if ((concat.random && ! seed_random(dest)) || ! start_output(dest, concat.finite)) {
+		return 1;
+	}
+
+	while (range_concat_next(&concat, &value, &index)) {
+		if (printed > 0) {
+			print_separator(dest);
+		}
+		multi_printf(dest->dimensions[index].format, value);
+		printed++;
+
+		if (is_output_stopped()) {
+			break;
+		}
+	}
+
+	return conclude_output(dest);
+}
+
+/** Prints the primes among the values of a single range
+ *
+ * Each value is looked up in a segmented sieve.  --limit=COUNT counts
+ * primes printed rather than values looked at.
+ *
+ * @param[in,out] dest Scaffolding to work with
+ *
+ * @return exit code, i.e. 0 on success and 1 on errors
+ *
+ * @since 1.2
+ */
+static int print_primes(scaffolding * dest) {
+	const int limited = CHECK_FLAG(dest->flags, FLAG_LIMIT_SET);
+	int done = limited && (dest->limit == 0);
+	unsigned long printed = 0;
+	unsigned long count;
+	prime_sieve sieve;
+	prime_status status = PRIME_SUCCESS;
+
+	/* Values beyond the limit may still be primes */
+	dest->flags &= ~FLAG_LIMIT_SET;
+
+	if (count_values(dest, &count)) {
+		if (count == 0) {
+			done = 1;
+		} else if ((value_at_position(dest, 0) > PRIME_MAX)
+				|| (value_at_position(dest, count - 1) > PRIME_MAX)) {
+			print_problem(USER_ERROR, "Combining --primes and values beyond 2^53 not supported.");
+			return 1;
+		}
+	}
+
+	if (! prime_sieve_init(&sieve)) {
+		print_problem(OUTOFMEM_ERROR);
+		return 1;
+	}
+
+	if (! start_output(dest, limited || HAS_COUNT(dest))) {
+		prime_sieve_free(&sieve);
+		return 1;
+	}
+
+	while (! done) {
+		double value;
+		const yield_status yield = enum_yield(dest, &value);
+		int prime;
+
+		status = prime_sieve_check(&sieve, value, &prime);
+		if (status != PRIME_SUCCESS) {
+			break;
+		}
+
+		if (prime) {
+			if (printed > 0) {
+				print_separator(dest);
+			}
+			multi_printf(dest->format, value);
+			printed++;
+		}
+
+		done = (yield != YIELD_MORE) || (limited && (printed == dest->limit))
+			|| is_output_stopped();
+	}
+	prime_sieve_free(&sieve);
+
+	switch (status) {
+	case PRIME_TOO_LARGE:
+		/* Only infinite ranges get here, end what was printed properly */
+		conclude_output(dest);
+		print_problem(ERROR, "Values beyond 2^53 reached, --primes stopped there.");
+		return 1;
+	case PRIME_OUT_OF_MEMORY:
+		print_problem(OUTOFMEM_ERROR);
+		return 1;
+	default:
+		break;
+	}
+
+	return conclude_output(dest);
+}
+
+/** Prints numbers read from stdin, reformatted
+ *
+ * Without -f|--format, numbers keep their decimal places unless
+ * -p|--precision is given.  --skip=COUNT and --limit=COUNT apply to
+ * the numbers read.
+ *
+ * @param[in,out] dest Scaffolding to work with
+ *
+ * @return exit code, i.e. 0 on success and 1 on errors
+ *
+ * @since 1.2
+ */
+static int print_from_stdin(scaffolding * dest) {
+	const int limited = CHECK_FLAG(dest->flags, FLAG_LIMIT_SET);
+	char * formats[INPUT_MAX_PRECISION + 1];
+	input_reader reader;
+	input_status status = INPUT_NUMBER;
+	unsigned long read_count = 0;
+	unsigned long printed = 0;
+	int ret = 0;
+	unsigned int i;
+
+	if (! dest->format && CHECK_FLAG(dest->flags, FLAG_USER_PRECISION)
+			&& ! make_default_format_string(dest, dest->user_precision)) {
+		print_problem(OUTOFMEM_ERROR);
+		return 1;
+	}
+
+	if (! set_default_separators(dest)) {
+		return 1;
+	}
+
+	for (i = 0; i <= INPUT_MAX_PRECISION; i++) {
+		formats[i] = NULL;
+	}
+
+	if (! input_init(&reader, 0, INPUT_BLOCK_SIZE)) {
+		print_problem(OUTOFMEM_ERROR);
+		return 1;
+	}
+
+	if (! start_output(dest, 1)) {
+		input_free(&reader);
+		return 1;
+	}
+
+	while (! (limited && (printed == dest->limit)) && ! is_output_stopped()) {
+		double value;
+		unsigned int precision;
+		const char * format = dest->format;
+
+		status = input_next_number(&reader, &value, &precision);
+		if (status != INPUT_NUMBER) {
+			break;
+		}
+		if (read_count++ < dest->skip) {
+			continue;
+		}
+
+		/* Keep decimal places as read */
+		if (! format) {
+			precision = ENUM_MIN(precision, INPUT_MAX_PRECISION);
+			if (! formats[precision]) {
+				formats[precision] = (char *)malloc(16);
+				if (! formats[precision]) {
+					print_problem(OUTOFMEM_ERROR);
+					ret = 1;
+					break;
+				}
+				sprintf(formats[precision], "%%.%uf", precision);
+			}
+			format = formats[precision];
+		}
+
+		if (printed > 0) {
+			print_separator(dest);
+		}
+		multi_printf(format, value);
+		printed++;
+	}
+
+	switch (status) {
+	case INPUT_INVALID:
+		print_problem(ERROR, "Invalid number \"%.*s\" on standard input.",
+			(int)ENUM_MIN(reader.token_length, 40), reader.token);
+		ret = 1;
+		break;
+	case INPUT_TOO_LONG:
+		print_problem(ERROR, "Token on standard input too long.");
+		ret = 1;
+		break;
+	case INPUT_READ_ERROR:
+		print_problem(ERROR, "Could not read standard input.");
+		ret = 1;
+		break;
+	default:
+		break;
+	}
+
+	for (i = 0; i <= INPUT_MAX_PRECISION; i++) {
+		free(formats[i]);
+	}
+	input_free(&reader);
+
+	return conclude_output(dest) || ret;
+}
+
+/** Adds an input record and its rendered value to a batch
+ *
+ * @param[in,out] batch
+ * @param[in] value Rendered value
+ * @param[in] body Record including delimiter
+ * @param[in] body_length Number of bytes of record
+ *
+ * @return zero if out of memory, non-zero otherwise
+ *
+ * @since 1.2
+ */
+static int add_numbered_record(numbered_batch * batch, text_buffer const * value,
+		const char * body, size_t body_length) {
+	const int copy = (body_length <= NUMBERED_COPY_MAX);
+	const size_t length = value->length + batch->field_separator_length
+		+ (copy ? body_length : 0);
+	numbered_piece * last = (batch->piece_count > 0)
+		? batch->pieces + batch->piece_count - 1
+		: NULL;
+	char * walker;
+
+	if (batch->text_length + length > batch->text_capacity) {
+		const size_t capacity = ENUM_MAX(2 * batch->text_capacity,
+			batch->text_length + length);
+		char * const grown = (char *)realloc(batch->text, capacity);
+		if (! grown) {
+			return 0;
+		}
+		batch->text = grown;
+		batch->text_capacity = capacity;
+	}
+
+	walker = batch->text + batch->text_length;
+	memcpy(walker, value->data, value->length);
+	walker += value->length;
+	memcpy(walker, batch->field_separator, batch->field_separator_length);
+	walker += batch->field_separator_length;
+	if (copy) {
+		memcpy(walker, body, body_length);
+	}
+
+	/* Text following text makes a single piece */
+	if (last && ! last->body) {
+		last->length += length;
+	} else {
+		last = batch->pieces + batch->piece_count++;
+		last->body = NULL;
+		last->offset = batch->text_length;
+		last->length = length;
+	}
+	batch->text_length += length;
+
+	if (! copy) {
+		last = batch->pieces + batch->piece_count++;
+		last->body = body;
+		last->offset = 0;
+		last->length = body_length;
+	}
+	batch->count++;
+	return 1;
+}
+
+/** Writes and empties a batch of numbered records
+ *
+ * Without --digest or --verify=FILE, the pieces of all records go to
+ * stdout by as few writev calls as possible so that long records are
+ * never copied.
  *
- * @since 0.5
+ * @param[in,out] batch
+ *
+ * @return zero if writing failed, non-zero otherwise
+ *
+ * @since 1.2
  */
-void free_malloced_argv(int argc, char *** pargv) {
-	int i = 0;
-	for (; i < argc; i++) {
-		free((*pargv)[i]);
-		(*pargv)[i] = NULL;
+static int write_numbered_batch(numbered_batch * batch) {
+	const unsigned int piece_count = batch->piece_count;
+	unsigned int i;
+
+	batch->piece_count = 0;
+	batch->count = 0;
+	batch->text_length = 0;
+
+#if defined(HAVE_WRITEV) && defined(HAVE_SYS_UIO_H)
+	if (batch->direct) {
+		struct iovec pieces[2 * NUMBERED_BATCH_SIZE];
+		struct iovec * walker = pieces;
+		int left = 0;
+
+		for (i = 0; i < piece_count; i++) {
+			numbered_piece const * const piece = batch->pieces + i;
+
+			pieces[left].iov_base = piece->body
+				? (char *)piece->body
+				: batch->text + piece->offset;
+			pieces[left++].iov_len = piece->length;
+		}
+
+		/* Anything printed through stdio goes first */
+		fflush(stdout);
+
+		while (left > 0) {
+			ssize_t written = writev(STDOUT_FILENO, walker, ENUM_MIN(left, batch->vector_max));
+			if (written < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				return 0;
+			}
+
+			/* Skip pieces written, resume inside a piece written partially */
+			while ((left > 0) && ((size_t)written >= walker->iov_len)) {
+				written -= walker->iov_len;
+				walker++;
+				left--;
+			}
+			if (left > 0) {
+				walker->iov_base = (char *)walker->iov_base + written;
+				walker->iov_len -= written;
+			}
+		}
+		return 1;
 	}
-	free(*pargv);
-	pargv = NULL;
+#endif
+
+	for (i = 0; i < piece_count; i++) {
+		numbered_piece const * const piece = batch->pieces + i;
+
+		output_bytes(piece->body ? piece->body : batch->text + piece->offset,
+			piece->length);
+	}
+	return 1;
 }
 
-/** Prints terminator, frees allocated memory
+/** Prints records read from stdin, each prefixed with the next value
+ *
+ * Records end with a newline, or a null byte with -z|--null, and keep
+ * their delimiter.  Value and record are separated by the field
+ * separator (default: tab).  Numbering ends with the last value, even
+ * if more records follow.  Input is mapped into memory where possible
+ * and read in large blocks otherwise.
  *
  * @param[in,out] dest Scaffolding to work with
  *
- * @since 1.1
+ * @return exit code, i.e. 0 on success and 1 on errors
+ *
+ * @since 1.2
  */
-static void finalize_output(scaffolding * dest) {
-	if (dest->terminator) {
-		printf("%s", dest->terminator);
-		free(dest->terminator);
+static int print_numbered_lines(scaffolding * dest) {
+	const char delimiter = CHECK_FLAG(dest->flags, FLAG_NULL_BYTES) ? '\0' : '\n';
+	numbered_batch batch;
+	input_reader reader;
+	text_buffer value;
+	unsigned long window;
+	int more = ! count_window(dest, &window) || (window > 0);
+	int ret = 0;
+
+	/* Records bring their own delimiters */
+	if (! dest->terminator) {
+		dest->terminator = enum_strdup("");
+		if (! dest->terminator) {
+			print_problem(OUTOFMEM_ERROR);
+			return 1;
+		}
+	}
+
+	batch.piece_count = 0;
+	batch.count = 0;
+	batch.text = NULL;
+	batch.text_length = 0;
+	batch.text_capacity = 0;
+	batch.field_separator = dest->field_separator ? dest->field_separator : "\t";
+	batch.field_separator_length = strlen(batch.field_separator);
+	batch.direct = ! CHECK_FLAG(dest->flags, FLAG_DIGEST) && ! dest->verify_file;
+	batch.vector_max = VECTOR_MAX;
+#ifdef _SC_IOV_MAX
+	if (sysconf(_SC_IOV_MAX) > VECTOR_MAX) {
+		batch.vector_max = (int)ENUM_MIN(sysconf(_SC_IOV_MAX), 2 * NUMBERED_BATCH_SIZE);
+	}
+#endif
+
+	value.data = NULL;
+	value.length = 0;
+	value.capacity = 0;
+
+	if (! input_init(&reader, 0, INPUT_BLOCK_SIZE)) {
+		print_problem(OUTOFMEM_ERROR);
+		return 1;
+	}
+	input_map(&reader);
+
+	if (! start_output(dest, 1)) {
+		input_free(&reader);
+		return 1;
+	}
+
+	while (more && ! is_output_stopped()) {
+		const char * const body = reader.data + reader.start;
+		const char * const found = (const char *)memchr(body, delimiter,
+			reader.end - reader.start);
+		size_t body_length;
+		double out;
+
+		if (found) {
+			body_length = found + 1 - body;
+		} else if (reader.eof) {
+			/* Last record without delimiter */
+			if (reader.start == reader.end) {
+				break;
+			}
+			body_length = reader.end - reader.start;
+		} else {
+			/* Record may continue in the next block, moving the buffer */
+			if (! write_numbered_batch(&batch)) {
+				print_problem(ERROR, "Could not write standard output.");
+				ret = 1;
+				break;
+			}
+			if ((reader.start == 0) && (reader.end == reader.capacity)
+					&& ! input_grow(&reader)) {
+				print_problem(OUTOFMEM_ERROR);
+				ret = 1;
+				break;
+			}
+			if (input_refill(&reader) < 0) {
+				print_problem(ERROR, "Could not read standard input.");
+				ret = 1;
+				break;
+			}
+			continue;
+		}
+
+		more = (enum_yield(dest, &out) == YIELD_MORE);
+		if ((multi_printf_text(dest->format, out, &value) != CUSTOM_PRINTF_SUCCESS)
+				|| ! add_numbered_record(&batch, &value, body, body_length)) {
+			print_problem(OUTOFMEM_ERROR);
+			ret = 1;
+			break;
+		}
+		reader.start += body_length;
+
+		if ((batch.count == NUMBERED_BATCH_SIZE) && ! write_numbered_batch(&batch)) {
+			print_problem(ERROR, "Could not write standard output.");
+			ret = 1;
+			break;
+		}
+	}
+
+	if ((ret == 0) && ! write_numbered_batch(&batch)) {
+		print_problem(ERROR, "Could not write standard output.");
+		ret = 1;
+	}
+
+	free(batch.text);
+	free(value.data);
+	input_free(&reader);
+
+	return conclude_output(dest) || ret;
+}
+
+/** Prints random strings, one for each value of a single range
+ *
+ * Characters for many strings are drawn at once, see
+ * enum_random_text().
+ *
+ * @param[in,out] dest Scaffolding to work with
+ *
+ * @return exit code, i.e. 0 on success and 1 on errors
+ *
+ * @since 1.2
+ */
+static int print_random_strings(scaffolding * dest) {
+	const size_t length = dest->string_length;
+	const size_t size = strlen(dest->string_alphabet);
+	const size_t batch_count = ENUM_MAX(STRING_BATCH_SIZE / length, 1);
+	char * const batch = (char *)malloc(batch_count * length);
+	unsigned long window;
+	const int finite = count_window(dest, &window);
+	unsigned long printed = 0;
+
+	if (! batch) {
+		print_problem(OUTOFMEM_ERROR);
+		return 1;
+	}
+
+	if (! start_output(dest, finite)) {
+		free(batch);
+		return 1;
+	}
+
+	while ((! finite || (printed < window)) && ! is_output_stopped()) {
+		const size_t count = finite ? ENUM_MIN(window - printed, batch_count) : batch_count;
+		size_t i;
+
+		enum_random_text(batch, count * length, dest->string_alphabet, size);
+		for (i = 0; i < count; i++) {
+			if (printed > 0) {
+				print_separator(dest);
+			}
+			output_bytes(batch + i * length, length);
+			printed++;
+		}
+	}
+
+	free(batch);
+	return conclude_output(dest);
+}
+
+/** Reports a problem with the files of --choose-from=FILE and --weights=FILE
+ *
+ * @param[in] dest Scaffolding to work with
+ * @param[in] status Problem to report
+ * @param[in] filename File with the problem
+ * @param[in] count Number of lines to choose from
+ *
+ * @since 1.2
+ */
+static void report_choice_problem(scaffolding const * dest, choice_status status,
+		const char * filename, size_t count) {
+	switch (status) {
+	case CHOICE_UNREADABLE:
+		print_problem(ERROR, "Could not read file \"%s\".", filename);
+		break;
+	case CHOICE_EMPTY:
+		print_problem(USER_ERROR, "File \"%s\" has no lines to choose from.", filename);
+		break;
+	case CHOICE_INVALID_WEIGHT:
+		print_problem(USER_ERROR, "Weights in file \"%s\" must be non-negative numbers, not all zero.", filename);
+		break;
+	case CHOICE_WEIGHT_COUNT:
+		print_problem(USER_ERROR, "File \"%s\" must have one weight for each of the %lu lines of file \"%s\".",
+			filename, (unsigned long)count, dest->choice_file);
+		break;
+	default:
+		print_problem(OUTOFMEM_ERROR);
+		break;
+	}
+}
+
+/** Prints random lines of a file, one for each value of a single range
+ *
+ * The file is loaded and indexed once.  Lines are picked with the same
+ * probability each, or in proportion to the weights given by
+ * --weights=FILE using an alias table.
+ *
+ * @param[in,out] dest Scaffolding to work with
+ *
+ * @return exit code, i.e. 0 on success and 1 on errors
+ *
+ * @since 1.2
+ */
+static int print_choices(scaffolding * dest) {
+	const int weighted = (dest->weights_file != NULL);
+	line_file lines;
+	alias_table table;
+	choice_status status;
+	unsigned long window;
+	const int finite = count_window(dest, &window);
+	unsigned long printed = 0;
+	int started;
+
+	status = line_file_load(&lines, dest->choice_file);
+	if (status != CHOICE_SUCCESS) {
+		report_choice_problem(dest, status, dest->choice_file, 0);
+		return 1;
+	}
+
+	if (weighted) {
+		status = alias_table_load(&table, dest->weights_file, lines.count);
+		if (status != CHOICE_SUCCESS) {
+			report_choice_problem(dest, status, dest->weights_file, lines.count);
+			line_file_free(&lines);
+			return 1;
+		}
+	}
+
+	started = start_output(dest, finite);
+	if (started) {
+		while ((! finite || (printed < window)) && ! is_output_stopped()) {
+			const size_t index = weighted
+				? alias_table_draw(&table)
+				: (size_t)enum_random_index((double)lines.count);
+
+			if (printed > 0) {
+				print_separator(dest);
+			}
+			output_bytes(LINE_TEXT(&lines, index), LINE_LENGTH(&lines, index));
+			printed++;
+		}
+	}
+
+	if (weighted) {
+		alias_table_free(&table);
+	}
+	line_file_free(&lines);
+	return started ? conclude_output(dest) : 1;
+}
+
+/** Prints a random walk starting at left, one value for each value of
+ * a single range
+ *
+ * @param[in,out] dest Scaffolding to work with
+ * @param[in] bounded Whether right was given, keeping values between
+ *                    left and right
+ *
+ * @return exit code, i.e. 0 on success and 1 on errors
+ *
+ * @since 1.2
+ */
+static int print_walk(scaffolding * dest, int bounded) {
+	double values[WALK_BATCH_SIZE];
+	random_walk walk;
+	unsigned long window;
+	const int finite = count_window(dest, &window);
+	unsigned long printed = 0;
+
+	random_walk_init(&walk, dest->walk, dest->left, dest->step, bounded, dest->right);
+
+	if (! start_output(dest, finite)) {
+		return 1;
+	}
+
+	while ((! finite || (printed < window)) && ! is_output_stopped()) {
+		const size_t count = finite ? ENUM_MIN(window - printed, WALK_BATCH_SIZE) : WALK_BATCH_SIZE;
+		size_t i;
+
+		random_walk_batch(&walk, values, count);
+		for (i = 0; i < count; i++) {
+			if (printed > 0) {
+				print_separator(dest);
+			}
+			multi_printf(dest->format, values[i]);
+			printed++;
+		}
+	}
+
+	return conclude_output(dest);
+}
+
+/** Prints the union or intersection of several ranges
+ *
+ * Values are printed in ascending order, without duplicates and without
+ * values of ranges marked --except.
+ *
+ * @param[in,out] dest Scaffolding to work with
+ *
+ * @return exit code, i.e. 0 on success and 1 on errors
+ *
+ * @since 1.2
+ */
+static int print_set(scaffolding * dest) {
+	progression * const included = (progression *)malloc(dest->dimension_count * sizeof(progression));
+	progression * const excluded = (progression *)malloc(dest->dimension_count * sizeof(progression));
+	unsigned int included_count = 0;
+	unsigned int excluded_count = 0;
+	int finite;
+	progression_merge merge;
+	progression_status status = PROGRESSION_SUCCESS;
+	unsigned long printed = 0;
+	double value;
+	unsigned int i;
+
+	if (! included || ! excluded) {
+		free(included);
+		free(excluded);
+		print_problem(OUTOFMEM_ERROR);
+		return 1;
+	}
+
+	for (i = 0; i < dest->dimension_count; i++) {
+		progression * const target = CHECK_FLAG(dest->dimensions[i].flags, FLAG_EXCEPT)
+			? excluded + excluded_count++
+			: included + included_count++;
+		make_progression(dest->dimensions + i, target);
+	}
+
+	if (included_count == 0) {
+		free(included);
+		free(excluded);
+		print_problem(USER_ERROR, "Ranges other than those marked --except needed.");
+		return 1;
+	}
+
+	if (dest->operation == SET_UNION) {
+		finite = 1;
+		for (i = 0; i < included_count; i++) {
+			if (included[i].infinite) {
+				finite = CHECK_FLAG(dest->flags, FLAG_LIMIT_SET);
+			}
+		}
 	} else {
-		printf("\n");
+		finite = CHECK_FLAG(dest->flags, FLAG_LIMIT_SET);
+		for (i = 0; i < included_count; i++) {
+			if (! included[i].infinite) {
+				finite = 1;
+			}
+		}
 	}
 
-	free(dest->format);
-	free(dest->separator);
+	status = progression_merge_init(&merge, dest->operation,
+		included, included_count, excluded, excluded_count);
+	free(included);
+	free(excluded);
+
+	if (status != PROGRESSION_SUCCESS) {
+		if (status == PROGRESSION_TOO_LARGE) {
+			print_problem(USER_ERROR, "Ranges too large for --intersection.");
+		} else {
+			print_problem(OUTOFMEM_ERROR);
+		}
+		return 1;
+	}
+
+	if (! start_output(dest, finite)) {
+		progression_merge_free(&merge);
+		return 1;
+	}
+
+	while (! (CHECK_FLAG(dest->flags, FLAG_LIMIT_SET) && (printed == dest->limit))
+			&& ! is_output_stopped()
+			&& progression_merge_next(&merge, &value)) {
+		if (printed > 0) {
+			print_separator(dest);
+		}
+		multi_printf(dest->dimensions[0].format, value);
+		printed++;
+	}
+
+	progression_merge_free(&merge);
+	return conclude_output(dest);
 }
 
 int main(int argc, char **argv) {
 	int argpos;
 	scaffolding dest;
-	float out;
+	time_formatter formatter;
+	word_counter counter;
+	double out;
+	unsigned long window;
+	int bounded;
 	int ret;
 	int i = 0;
-	int newargc;
-	char ** newargv;
 
 	initialize_scaffold(&dest);
 
@@ -107,16 +2082,66 @@ int main(int argc, char **argv) {
 		break;
 	}
 
-	if (! preparse_args(argc - argpos, argv + argpos, &newargc, &newargv)) {
-		free_malloced_argv(newargc, &newargv);
+	if (CHECK_FLAG(dest.flags, FLAG_FROM_STDIN)) {
+		if (argpos < argc) {
+			print_problem(USER_ERROR, "Combining --from-stdin and arguments not supported.");
+			return 1;
+		}
+		return print_from_stdin(&dest);
+	}
+
+	if (CHECK_FLAG(dest.flags, FLAG_NUMBER_LINES) && (argpos == argc)) {
+		/* Count lines from 1 like cat -n */
+		SET_LEFT(dest, 1.0);
+	} else if (((dest.string_length > 0) || dest.choice_file) && (argpos == argc)) {
+		/* A single string or line */
+		SET_LEFT(dest, 1.0);
+		SET_RIGHT(dest, 1.0);
+	} else if (! parse_ranges(argc - argpos, argv + argpos, &dest)) {
 		return 1;
 	}
 
-	if (! parse_args(newargc, newargv, &dest)) {
-		free_malloced_argv(newargc, &newargv);
+	if (dest.dimension_count > 0) {
+		const ranges_status status = complete_ranges(&dest);
+
+		if (status != RANGES_SUCCESS) {
+			report_ranges_problem(status);
+			return 1;
+		}
+		if (! set_default_separators(&dest)) {
+			return 1;
+		}
+		if (CHECK_FLAG(dest.flags, FLAG_CONCAT)) {
+			return print_concat(&dest);
+		}
+		if (dest.operation != SET_NONE) {
+			return print_set(&dest);
+		}
+		return CHECK_FLAG(dest.flags, FLAG_ZIP)
+			? print_zip(&dest)
+			: print_product(&dest);
+	}
+
+	if ((dest.field_separator && ! CHECK_FLAG(dest.flags, FLAG_NUMBER_LINES))
+			|| (dest.field_format_count > 0)
+			|| (dest.order != ORDER_ROW) || CHECK_FLAG(dest.flags, FLAG_ZIP)
+			|| CHECK_FLAG(dest.flags, FLAG_CONCAT) || (dest.operation != SET_NONE)) {
+		print_problem(USER_ERROR, "Parameters --field-separator=TEXT, --field-format=FORMAT, --order=ORDER, --zip, --concat, --union and --intersection require several ranges.");
 		return 1;
 	}
-	free_malloced_argv(newargc, &newargv);
+
+	if (! prepare_geometric(&dest)) {
+		return 1;
+	}
+
+	/* Walks stay between left and right if given */
+	bounded = HAS_RIGHT((&dest));
+
+	/* Without a count, draw as many values as there are records */
+	if (CHECK_FLAG(dest.flags, FLAG_NUMBER_LINES) && CHECK_FLAG(dest.flags, FLAG_RANDOM)
+			&& ! HAS_COUNT((&dest))) {
+		SET_COUNT(dest, ULONG_MAX);
+	}
 
 	complete_scaffold(&dest);
 
@@ -125,6 +2150,26 @@ int main(int argc, char **argv) {
 		return 1;
 	}
 
+	if (dest.alphabet && ! is_word_range(&dest)) {
+		print_problem(USER_ERROR, "Parameter --alphabet=CHARS requires whole steps and values of 1 and above.");
+		return 1;
+	}
+
+	if (CHECK_FLAG(dest.flags, FLAG_REVERSE) && ! HAS_COUNT((&dest))) {
+		print_problem(USER_ERROR, "Combining --reverse and infinity not supported.");
+		return 1;
+	}
+
+	if ((dest.shard_count > 0) && ! count_window(&dest, &window)) {
+		print_problem(USER_ERROR, "Combining --shard and infinity not supported.");
+		return 1;
+	}
+
+	if ((dest.chunk_count > 0) && ! count_window(&dest, &window)) {
+		print_problem(USER_ERROR, "Combining --chunks and infinity not supported.");
+		return 1;
+	}
+
 	if (!dest.format) {
 		unsigned int precision = CHECK_FLAG(dest.flags, FLAG_USER_PRECISION)
 			? dest.user_precision
@@ -132,46 +2177,112 @@ int main(int argc, char **argv) {
 		make_default_format_string(&dest, precision);
 	}
 
-	if (! dest.separator) {
-		dest.separator = enum_strdup("\n");
-		if (! dest.separator) {
-			print_problem(OUTOFMEM_ERROR);
-			return 1;
-		}
+	if (! set_default_separators(&dest)) {
+		return 1;
 	}
 
-	if (CHECK_FLAG(dest.flags, FLAG_RANDOM)) {
-		unsigned int const seed = CHECK_FLAG(dest.flags, FLAG_USER_SEED)
-			? dest.seed
-			: (unsigned int)(time(NULL) + getpid());
-		srand(seed);
+	if ((CHECK_FLAG(dest.flags, FLAG_RANDOM) || (dest.string_length > 0) || dest.choice_file
+			|| (dest.walk != WALK_NONE)) && ! seed_random(&dest)) {
+		return 1;
+	}
+
+	if (dest.string_length > 0) {
+		return print_random_strings(&dest);
+	}
+
+	if (dest.choice_file) {
+		return print_choices(&dest);
+	}
+
+	if (dest.walk != WALK_NONE) {
+		return print_walk(&dest, bounded);
+	}
+
+	if (CHECK_FLAG(dest.flags, FLAG_PRIMES)) {
+		return print_primes(&dest);
 	}
 
-	if (CHECK_FLAG(dest.flags, FLAG_COUNT_SET) && (dest.count == 0)) {
+	if (CHECK_FLAG(dest.flags, FLAG_NUMBER_LINES)) {
+		return print_numbered_lines(&dest);
+	}
+
+	if (dest.chunk_count > 0) {
+		print_chunks(&dest, window);
 		finalize_output(&dest);
 		return 0;
 	}
 
-	while (1) {
-		ret = enum_yield(&dest, &out);
+	if (dest.query != QUERY_NONE) {
+		return answer_query(&dest);
+	}
 
-		if (i != 0) {
-			if (CHECK_FLAG(dest.flags, FLAG_NULL_BYTES)) {
-				fputc('\0', stdout);
-			} else {
-				printf("%s", dest.separator);
-			}
+	if (CHECK_FLAG(dest.flags, FLAG_PREDICT_SIZE)) {
+		if (! count_window(&dest, &window)) {
+			print_problem(USER_ERROR, "Combining --predict-size and infinity not supported.");
+			return 1;
+		}
+		print_size_prediction(&dest, window);
+		return 0;
+	}
+
+	if (dest.aggregates != 0) {
+		if (! count_window(&dest, &window)) {
+			print_problem(USER_ERROR, "Combining aggregates and infinity not supported.");
+			return 1;
 		}
+		return print_aggregates(&dest, window);
+	}
 
-		multi_printf(dest.format, out);
+	if (CHECK_FLAG(dest.flags, FLAG_TIME)
+			&& (time_formatter_init(&formatter, dest.time_format) != TIME_FORMAT_SUCCESS)) {
+		print_problem(OUTOFMEM_ERROR);
+		return 1;
+	}
 
-		if (ret != YIELD_MORE)
-			break;
+	if (dest.alphabet && ! word_counter_init(&counter, dest.alphabet)) {
+		print_problem(OUTOFMEM_ERROR);
+		return 1;
+	}
 
-		i++;
+	if (! start_output(&dest, count_window(&dest, &window))) {
+		return 1;
 	}
 
-	finalize_output(&dest);
+	/* Anything left to print after skipping and limiting? */
+	if (! count_window(&dest, &window) || (window > 0)) {
+		while (1) {
+			ret = enum_yield(&dest, &out);
 
-	return 0;
+			if (i != 0) {
+				print_separator(&dest);
+			}
+
+			if (CHECK_FLAG(dest.flags, FLAG_TIME)) {
+				time_formatter_render(&formatter, out);
+				output_bytes(formatter.line, formatter.length);
+			} else if (dest.alphabet) {
+				word_counter_render(&counter, out);
+				output_bytes(WORD_TEXT(&counter), WORD_LENGTH(&counter));
+			} else {
+				multi_printf(dest.format, out);
+			}
+
+			if ((ret != YIELD_MORE) || is_output_stopped())
+				break;
+
+			i++;
+		}
+
+		/* Values of the next shard follow */
+		if (! is_last_shard(&dest)) {
+			print_separator(&dest);
+		}
+	}
+
+	if (CHECK_FLAG(dest.flags, FLAG_TIME)) {
+		time_formatter_free(&formatter);
+	} else if (dest.alphabet) {
+		word_counter_free(&counter);
+	}
+	return conclude_output(&dest);
 }
@@ -0,0 +1,400 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ordering.h"
+#include "assertion.h"
+#include "utils.h"
+
+#include <stdlib.h>  /* for malloc */
+#include <limits.h>  /* for CHAR_BIT */
+
+/** Number of bits in an unsigned long
+ *
+ * @since 1.2
+ */
+#define ULONG_BITS  (sizeof(unsigned long) * CHAR_BIT)
+
+/** Number of bits needed to tell apart positions 0 to count - 1
+ *
+ * @param[in] count
+ *
+ * @return number of bits
+ *
+ * @since 1.2
+ */
+static unsigned int bits_for_count(unsigned long count) {
+	unsigned int bits = 0;
+
+	assert(count > 0);
+	for (count--; count > 0; count >>= 1) {
+		bits++;
+	}
+	return bits;
+}
+
+/** Gather the bits of value selected by mask into the lowest bits
+ *
+ * This is what the PEXT instruction does in hardware.
+ *
+ * @param[in] value
+ * @param[in] mask
+ *
+ * @return gathered bits
+ *
+ * @since 1.2
+ */
+static unsigned long extract_bits(unsigned long value, unsigned long mask) {
+	unsigned long result = 0;
+	unsigned long bit = 1;
+
+	while (mask != 0) {
+		const unsigned long lowest = mask & (~mask + 1);
+		if (value & lowest) {
+			result |= bit;
+		}
+		bit <<= 1;
+		mask &= mask - 1;
+	}
+	return result;
+}
+
+/** Decode a Z-order code into positions
+ *
+ * @param[in,out] walk
+ *
+ * @since 1.2
+ */
+static void decode_morton(tuple_walk * walk) {
+	unsigned int i;
+
+	for (i = 0; i < walk->dimension_count; i++) {
+		walk->positions[i] = extract_bits(walk->code, walk->masks[i]);
+	}
+}
+
+/** Decode a Hilbert code into positions
+ *
+ * The code is first spread over positions, one bit per range at a
+ * time, most significant bits first.  These are then transformed from
+ * Gray code and undone of excess rotations and reflections, following
+ * J. Skilling, "Programming the Hilbert curve" (2004).
+ *
+ * @param[in,out] walk
+ *
+ * @since 1.2
+ */
+static void decode_hilbert(tuple_walk * walk) {
+	unsigned long * const x = walk->positions;
+	const unsigned int n = walk->dimension_count;
+	unsigned long q;
+	unsigned long t;
+	unsigned int i;
+	unsigned int level;
+
+	for (i = 0; i < n; i++) {
+		x[i] = 0;
+		for (level = 0; level < walk->bits; level++) {
+			if ((walk->code >> (level * n + (n - 1 - i))) & 1) {
+				x[i] |= 1UL << level;
+			}
+		}
+	}
+
+	if (walk->bits == 0) {
+		return;
+	}
+
+	/* Gray decode */
+	t = x[n - 1] >> 1;
+	for (i = n - 1; i > 0; i--) {
+		x[i] ^= x[i - 1];
+	}
+	x[0] ^= t;
+
+	/* Undo excess work */
+	for (q = 2; q != (1UL << walk->bits); q <<= 1) {
+		const unsigned long p = q - 1;
+		for (i = n; i > 0; i--) {
+			if (x[i - 1] & q) {
+				x[0] ^= p;
+			} else {
+				t = (x[0] ^ x[i - 1]) & p;
+				x[0] ^= t;
+				x[i - 1] ^= t;
+			}
+		}
+	}
+}
+
+/** Tells whether all positions are within their ranges
+ *
+ * @param[in] walk
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int is_inside(tuple_walk const * walk) {
+	unsigned int i;
+
+	for (i = 0; i < walk->dimension_count; i++) {
+		if (walk->positions[i] >= walk->counts[i]) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/** Find the run of Hilbert codes outside the ranges around the current one
+ *
+ * Aligned blocks of 2^(k * n) codes cover cubes of 2^k positions per
+ * range, starting at the positions cleared of their lowest k bits.  If
+ * that corner is beyond the end of a range, so is the whole block.
+ *
+ * @param[in] walk Walk with positions decoded from an outside code
+ *
+ * @return mask of the lowest code bits that can be skipped
+ *
+ * @since 1.2
+ */
+static unsigned long outside_hilbert_run(tuple_walk const * walk) {
+	const unsigned int n = walk->dimension_count;
+	unsigned long run = 0;
+	unsigned int level;
+	unsigned int i;
+
+	for (level = 1; level < walk->bits; level++) {
+		int outside = 0;
+		for (i = 0; i < n; i++) {
+			if (((walk->positions[i] >> level) << level) >= walk->counts[i]) {
+				outside = 1;
+				break;
+			}
+		}
+		if (! outside) {
+			break;
+		}
+		run = (1UL << (level * n)) - 1;
+	}
+	return run;
+}
+
+/** Start a walk at the first tuple.
+ *
+ * All counts need to be non-zero, except that the first range may be
+ * infinite (given as 0) with ORDER_ROW.
+ *
+ * @param[out] walk
+ * @param[in] order
+ * @param[in] dimension_count Number of ranges, at least 1
+ * @param[in] counts Number of values per range
+ * @param[in] tile_size Number of positions per tile and range (ORDER_TILED)
+ *
+ * @return status as represented by tuple_walk_status
+ *
+ * @since 1.2
+ */
+tuple_walk_status tuple_walk_init(tuple_walk * walk, tuple_order order,
+		unsigned int dimension_count, unsigned long const * counts,
+		unsigned long tile_size) {
+	unsigned int total_bits = 0;
+	unsigned int i;
+
+	assert(dimension_count > 0);
+
+	walk->order = order;
+	walk->dimension_count = dimension_count;
+	walk->counts = (unsigned long *)malloc(dimension_count * sizeof(unsigned long));
+	walk->positions = (unsigned long *)calloc(dimension_count, sizeof(unsigned long));
+	walk->masks = (unsigned long *)calloc(dimension_count, sizeof(unsigned long));
+	walk->tiles = (unsigned long *)calloc(dimension_count, sizeof(unsigned long));
+	walk->tile_size = tile_size;
+	walk->bits = 0;
+	walk->code = 0;
+	walk->code_count = 1;
+
+	if (! walk->counts || ! walk->positions || ! walk->masks || ! walk->tiles) {
+		tuple_walk_free(walk);
+		return TUPLE_WALK_OUT_OF_MEMORY;
+	}
+
+	for (i = 0; i < dimension_count; i++) {
+		walk->counts[i] = counts[i];
+		assert((counts[i] > 0) || ((i == 0) && (order == ORDER_ROW)));
+	}
+
+	switch (order) {
+	case ORDER_MORTON:
+		{
+			/* Deal bits of the code round-robin to ranges still needing bits */
+			unsigned int level;
+			int dealt = 1;
+
+			for (level = 0; dealt; level++) {
+				dealt = 0;
+				for (i = 0; i < dimension_count; i++) {
+					if (bits_for_count(counts[i]) > level) {
+						if (total_bits == ULONG_BITS - 1) {
+							tuple_walk_free(walk);
+							return TUPLE_WALK_TOO_LARGE;
+						}
+						walk->masks[i] |= 1UL << total_bits;
+						total_bits++;
+						dealt = 1;
+					}
+				}
+			}
+		}
+		break;
+
+	case ORDER_HILBERT:
+		for (i = 0; i < dimension_count; i++) {
+			walk->bits = ENUM_MAX(walk->bits, bits_for_count(counts[i]));
+		}
+		if (walk->bits * dimension_count >= ULONG_BITS) {
+			tuple_walk_free(walk);
+			return TUPLE_WALK_TOO_LARGE;
+		}
+		total_bits = walk->bits * dimension_count;
+		break;
+
+	case ORDER_ROW:
+	case ORDER_TILED:
+		break;
+
+	default:
+		assert(0);
+	}
+
+	walk->code_count = 1UL << total_bits;
+	return TUPLE_WALK_SUCCESS;
+}
+
+/** Advance a walk to the next tuple.
+ *
+ * @param[in,out] walk
+ *
+ * @return 1 if positions hold the next tuple, 0 after the last tuple
+ *
+ * @since 1.2
+ */
+int tuple_walk_next(tuple_walk * walk) {
+	const unsigned int n = walk->dimension_count;
+	unsigned int i;
+
+	switch (walk->order) {
+	case ORDER_ROW:
+		for (i = n; i > 0; i--) {
+			walk->positions[i - 1]++;
+			if ((walk->counts[i - 1] == 0)
+					|| (walk->positions[i - 1] < walk->counts[i - 1])) {
+				return 1;
+			}
+			walk->positions[i - 1] = 0;
+		}
+		return 0;
+
+	case ORDER_TILED:
+		/* Next position within current tile */
+		for (i = n; i > 0; i--) {
+			const unsigned long end = ENUM_MIN(walk->tiles[i - 1] + walk->tile_size,
+				walk->counts[i - 1]);
+			walk->positions[i - 1]++;
+			if (walk->positions[i - 1] < end) {
+				return 1;
+			}
+			walk->positions[i - 1] = walk->tiles[i - 1];
+		}
+
+		/* Next tile */
+		for (i = n; i > 0; i--) {
+			walk->tiles[i - 1] += walk->tile_size;
+			if (walk->tiles[i - 1] < walk->counts[i - 1]) {
+				walk->positions[i - 1] = walk->tiles[i - 1];
+				return 1;
+			}
+			walk->tiles[i - 1] = 0;
+			walk->positions[i - 1] = 0;
+		}
+		return 0;
+
+	case ORDER_MORTON:
+		while (++walk->code < walk->code_count) {
+			decode_morton(walk);
+			if (is_inside(walk)) {
+				return 1;
+			}
+		}
+		return 0;
+
+	case ORDER_HILBERT:
+		/* With ranges of very different sizes most codes are outside,
+		 * so whole blocks of them are skipped at once */
+		while (++walk->code < walk->code_count) {
+			decode_hilbert(walk);
+			if (is_inside(walk)) {
+				return 1;
+			}
+			walk->code |= outside_hilbert_run(walk);
+		}
+		return 0;
+
+	default:
+		assert(0);
+	}
+
+	return 0;
+}
+
+/** Free memory allocated for a walk.
+ *
+ * @param[in,out] walk
+ *
+ * @since 1.2
+ */
+void tuple_walk_free(tuple_walk * walk) {
+	free(walk->counts);
+	free(walk->positions);
+	free(walk->masks);
+	free(walk->tiles);
+	walk->counts = NULL;
+	walk->positions = NULL;
+	walk->masks = NULL;
+	walk->tiles = NULL;
+}
@@ -0,0 +1,97 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef ORDERING_H
+#define ORDERING_H 1
+
+/** Number of values per tile and range unless given by the user
+ *
+ * @since 1.2
+ */
+#define DEFAULT_TILE_SIZE  16
+
+/** Enumeration of orders to walk through the tuples of several ranges
+ *
+ * @since 1.2
+ */
+typedef enum _tuple_order {
+	ORDER_ROW,     /**< last range advances fastest, like nested loops (default) */
+	ORDER_MORTON,  /**< Z-order curve, interleaving bits of positions */
+	ORDER_HILBERT, /**< Hilbert curve, neighboring tuples differ by one step */
+	ORDER_TILED    /**< row-major tiles, row-major within each tile */
+} tuple_order;
+
+/** State of a walk through the tuples of several ranges
+ *
+ * Tuples are given as positions into each range.  Orders following a
+ * curve decode consecutive codes into positions, leaving out positions
+ * beyond the end of a range.
+ *
+ * @since 1.2
+ */
+typedef struct _tuple_walk {
+	tuple_order order;             /**< order of walking */
+	unsigned int dimension_count;  /**< number of ranges */
+	unsigned long * counts;        /**< number of values per range (0: infinite) */
+	unsigned long * positions;     /**< positions of current tuple */
+	unsigned long * masks;         /**< bits of a code belonging to each range (Morton) */
+	unsigned long * tiles;         /**< first positions of current tile (tiled) */
+	unsigned long tile_size;       /**< number of positions per tile and range (tiled) */
+	unsigned int bits;             /**< bits per range (Hilbert) */
+	unsigned long code;            /**< code of current tuple (Morton, Hilbert) */
+	unsigned long code_count;      /**< number of codes (Morton, Hilbert) */
+} tuple_walk;
+
+/** Enumeration of possible return values of tuple_walk_init()
+ *
+ * @since 1.2
+ */
+typedef enum _tuple_walk_status {
+	TUPLE_WALK_SUCCESS,
+	TUPLE_WALK_TOO_LARGE,   /**< codes would not fit into an unsigned long */
+	TUPLE_WALK_OUT_OF_MEMORY
+} tuple_walk_status;
+
+tuple_walk_status tuple_walk_init(tuple_walk * walk, tuple_order order,
+		unsigned int dimension_count, unsigned long const * counts,
+		unsigned long tile_size);
+int tuple_walk_next(tuple_walk * walk);
+void tuple_walk_free(tuple_walk * walk);
+
+#endif /* ORDERING_H */
@@ -43,11 +43,15 @@
 #include "info.h"
 #include "printing.h"
 #include "utils.h"
+#include "timestamps.h"
+#include "alphabet.h"
 
 #include <stdlib.h>
 #include <string.h>
 #include <getopt.h>
 #include <math.h>   /* for log10 */
+#include <errno.h>  /* for errno, ERANGE */
+#include <limits.h> /* for ULONG_MAX */
 
 /** Macro to have a boolean kind of answer about if a token is invalid somehow
  * @since 0.3
@@ -102,8 +106,8 @@ typedef enum _token_type {
  * @since 0.3
  */
 typedef union _setter_value {
-	unsigned int uint_data; /**< unsigned int */
-	float float_data;       /**< float */
+	unsigned long uint_data; /**< unsigned long */
+	double float_data;       /**< double */
 } setter_value;
 
 /** function_pointer to install a value into scaffold
@@ -132,6 +136,51 @@ typedef struct _use_case {
 	unsigned int random;          /**< bool for random usefulness */
 } use_case;
 
+/** Values returned by getopt_long for options without a short form
+ *
+ * @since 1.2
+ */
+enum _long_only_option {
+	OPTION_DISTRIBUTION = 256,
+	OPTION_SECURE,
+	OPTION_SKIP,
+	OPTION_LIMIT,
+	OPTION_SHARD,
+	OPTION_CHUNKS,
+	OPTION_ALIGN,
+	OPTION_NTH,
+	OPTION_INDEX_OF,
+	OPTION_CONTAINS,
+	OPTION_SUM,
+	OPTION_COUNT,
+	OPTION_MIN,
+	OPTION_MAX,
+	OPTION_MEAN,
+	OPTION_REVERSE,
+	OPTION_PREDICT_SIZE,
+	OPTION_DIGEST,
+	OPTION_VERIFY,
+	OPTION_FIELD_SEPARATOR,
+	OPTION_FIELD_FORMAT,
+	OPTION_ORDER,
+	OPTION_ZIP,
+	OPTION_CONCAT,
+	OPTION_UNION,
+	OPTION_INTERSECTION,
+	OPTION_GEOMETRIC,
+	OPTION_LOG_SPACED,
+	OPTION_TIME,
+	OPTION_ALPHABET,
+	OPTION_PRIMES,
+	OPTION_QUASI,
+	OPTION_FROM_STDIN,
+	OPTION_NUMBER_LINES,
+	OPTION_RANDOM_STRING,
+	OPTION_CHOOSE_FROM,
+	OPTION_WEIGHTS,
+	OPTION_WALK
+};
+
 /** from getopt */
 extern int opterr;
 extern int optopt;
@@ -160,7 +209,7 @@ static int set_scaffold_left(scaffolding * scaffold, setter_value value) {
 }
 
 static int set_scaffold_step(scaffolding * scaffold, setter_value value) {
-	if (value.float_data == 0.0f) {
+	if (value.float_data == 0.0) {
 		/* error code handled below */
 		return 0;
 	}
@@ -206,8 +255,8 @@ static int ends_with_x(const char *str) {
  *
  * @since 0.3
  */
-static int is_nan_or_inf(float f) {
-	const float INF = strtod("INF", NULL);
+static int is_nan_or_inf(double f) {
+	const double INF = strtod("INF", NULL);
 	return (enum_is_nan_float(f) || (f == INF) || (f == -INF)) ? 1 : 0;
 }
 
@@ -248,7 +297,7 @@ static token_type identify_token(const char *arg, setter_value *value) {
 			return TOKEN_MULTIPLIER;
 		}
 	} else {
-		const float f = strtod(arg, &end);
+		const double f = strtod(arg, &end);
 		if (end - arg == (int)strlen(arg)) {
 			if (is_nan_or_inf(f)) {
 				return TOKEN_ERROR_BAD_FLOAT;
@@ -315,7 +364,20 @@ typedef enum _parameter_error {
 	PARAMETER_ERROR_INVALID_PRECISION,
 	PARAMETER_ERROR_VERSION_NOT_ALONE,
 	PARAMETER_ERROR_HELP_NOT_ALONE,
-	PARAMETER_ERROR_INVALID_SEED
+	PARAMETER_ERROR_INVALID_SEED,
+	PARAMETER_ERROR_INVALID_SKIP,
+	PARAMETER_ERROR_INVALID_LIMIT,
+	PARAMETER_ERROR_INVALID_SHARD,
+	PARAMETER_ERROR_INVALID_CHUNKS,
+	PARAMETER_ERROR_INVALID_ALIGN,
+	PARAMETER_ERROR_INVALID_POSITION,
+	PARAMETER_ERROR_INVALID_VALUE,
+	PARAMETER_ERROR_QUERY_NOT_ALONE,
+	PARAMETER_ERROR_INVALID_RATIO,
+	PARAMETER_ERROR_INVALID_TIME_FORMAT,
+	PARAMETER_ERROR_INVALID_ALPHABET,
+	PARAMETER_ERROR_INVERTED_ALPHABET,
+	PARAMETER_ERROR_INVALID_STRING_LENGTH
 } parameter_error;
 
 /** Errors during parsing of arguments.
@@ -356,6 +418,45 @@ static void report_parameter_error(int code) {
 	case PARAMETER_ERROR_INVALID_SEED:
 		print_problem(USER_ERROR, "Seed must be a non-negative integer.");
 		break;
+	case PARAMETER_ERROR_INVALID_SKIP:
+		print_problem(USER_ERROR, "Skip must be a non-negative integer.");
+		break;
+	case PARAMETER_ERROR_INVALID_LIMIT:
+		print_problem(USER_ERROR, "Limit must be a non-negative integer.");
+		break;
+	case PARAMETER_ERROR_INVALID_SHARD:
+		print_problem(USER_ERROR, "Shard must be given as INDEX/COUNT with 1 <= INDEX <= COUNT.");
+		break;
+	case PARAMETER_ERROR_INVALID_CHUNKS:
+		print_problem(USER_ERROR, "Number of chunks must be a positive integer.");
+		break;
+	case PARAMETER_ERROR_INVALID_ALIGN:
+		print_problem(USER_ERROR, "Alignment must be a positive integer.");
+		break;
+	case PARAMETER_ERROR_INVALID_POSITION:
+		print_problem(USER_ERROR, "Position must be a positive integer.");
+		break;
+	case PARAMETER_ERROR_INVALID_VALUE:
+		print_problem(USER_ERROR, "Value must be a number.");
+		break;
+	case PARAMETER_ERROR_QUERY_NOT_ALONE:
+		print_problem(USER_ERROR, "--nth, --index-of and --contains must come alone.");
+		break;
+	case PARAMETER_ERROR_INVALID_RATIO:
+		print_problem(USER_ERROR, "Ratio must be a positive number other than 1.");
+		break;
+	case PARAMETER_ERROR_INVALID_TIME_FORMAT:
+		print_problem(USER_ERROR, "Time format supports fields %%Y, %%y, %%m, %%d, %%e, %%j, %%F, %%a, %%A, %%b, %%B, %%u, %%w, %%H, %%M, %%S, %%T, %%s and %%%% only.");
+		break;
+	case PARAMETER_ERROR_INVALID_ALPHABET:
+		print_problem(USER_ERROR, "Alphabet must have two or more distinct characters other than \".\" and \",\".");
+		break;
+	case PARAMETER_ERROR_INVERTED_ALPHABET:
+		print_problem(USER_ERROR, "Ranges of characters in an alphabet must ascend, e.g. \"a-z\" rather than \"z-a\".");
+		break;
+	case PARAMETER_ERROR_INVALID_STRING_LENGTH:
+		print_problem(USER_ERROR, "String length must be a positive integer.");
+		break;
 	default:
 		assert(0);
 	}
@@ -422,60 +523,6 @@ static int set_format_strdup(char ** dest, const char * new) {
 	return 1;
 }
 
-/** Store a default format string to scaffold.
- *
- * A default format string, consisting of a floating point number with decimal
- * places according to given precision, is created in allocated memory and then
- * stored into a scaffold's format key, scaffold->format.
- *
- * @param[in,out] dest
- * @param[in] precision
- *
- * @return boolean meaning of 1 or 0
- *
- * @since 0.4
- */
-int make_default_format_string(scaffolding * dest, unsigned int precision) {
-	char * newformat = NULL;
-	const size_t post_dot_bytes_needed = ((precision == 0) ? 0 : (size_t)log10(precision)) + 1;
-
-	if (HAS_RIGHT(dest) && CHECK_FLAG(dest->flags, FLAG_EQUAL_WIDTH)) {
-		const char * const equal_width_base = "%%0%u.%uf";
-		const int left_len = (dest->left < 0) + (size_t)log10(fabs(dest->left)) + 1;
-		const int right_len = (dest->right < 0) + (size_t)log10(fabs(dest->right)) + 1;
-		const unsigned int pre_dot_digits_wanted = ENUM_MAX(left_len, right_len);
-		const unsigned int total_chars_wanted = pre_dot_digits_wanted + (precision ? 1 + precision : 0);
-		const size_t pre_dot_bytes_needed = (size_t)log10(total_chars_wanted) + 1;
-		const size_t base_bytes = strlen(equal_width_base)
-			- strlen("%")
-			- strlen("%u") + pre_dot_bytes_needed
-			- strlen("%u") + post_dot_bytes_needed
-			+ 1;
-		newformat = (char *)malloc(base_bytes);
-		if (! newformat)
-		    return 0;
-		sprintf(newformat, equal_width_base, total_chars_wanted, precision);
-	} else {
-		const char * const default_base = "%%.%uf";
-		const size_t base_bytes = strlen(default_base)
-			- strlen("%")
-			- strlen("%u") + post_dot_bytes_needed
-			+ 1;
-		newformat = (char *)malloc(base_bytes);
-		if (! newformat)
-		    return 0;
-		sprintf(newformat, default_base, precision);
-	}
-
-	if (! set_format_strdup(&(dest->format), newformat)) {
-		free(newformat);
-		return 0;
-	}
-
-	free(newformat);
-	return 1;
-}
-
 typedef enum _separator_change {
 	APPLY_SEPARATOR = 1 << 0,
 	APPLY_NULL_BYTES = 1 << 1
@@ -692,6 +739,478 @@ static int analyze_format(const char * format) {
 	return 0;
 }
 
+/** Parse a non-negative integer given to a parameter like --skip.
+ *
+ * @param[in] text
+ * @param[out] dest
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int parse_non_negative(const char * text, unsigned long * dest) {
+	char * end;
+	unsigned long candidate;
+
+	errno = 0;
+	candidate = strtoul(text, &end, 10);
+	if ((*text == '\0') || (*end != '\0') || (strchr(text, '-') != NULL)
+			|| (errno == ERANGE)) {
+		return 0;
+	}
+
+	*dest = candidate;
+	return 1;
+}
+
+/** Append a format for the next range of a product to scaffold.
+ *
+ * @param[in,out] scaffold
+ * @param[in] format Valid format, still escaped
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int add_field_format(scaffolding * scaffold, const char * format) {
+	char * const unescaped = enum_strdup(format);
+	char ** formats;
+
+	if (! unescaped) {
+		return 0;
+	}
+	unescape(unescaped, GUARD_PERCENT);
+
+	formats = (char **)realloc(scaffold->field_formats,
+		(scaffold->field_format_count + 1) * sizeof(char *));
+	if (! formats) {
+		free(unescaped);
+		return 0;
+	}
+
+	formats[scaffold->field_format_count] = unescaped;
+	scaffold->field_formats = formats;
+	scaffold->field_format_count++;
+	return 1;
+}
+
+/** Save given shard specification to scaffold.
+ *
+ * The specification has the form "INDEX/COUNT", e.g. "2/8" for the second
+ * of eight shards.
+ *
+ * @param[in,out] scaffold
+ * @param[in] spec
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int set_shard(scaffolding * scaffold, const char * spec) {
+	const char * const slash = strchr(spec, '/');
+	unsigned long index;
+	unsigned long count;
+	char * index_text;
+	int success;
+
+	if (! slash) {
+		return 0;
+	}
+
+	index_text = enum_strndup(spec, slash - spec);
+	if (! index_text) {
+		return 0;
+	}
+	success = parse_non_negative(index_text, &index)
+		&& parse_non_negative(slash + 1, &count)
+		&& (index >= 1) && (index <= count);
+	free(index_text);
+
+	if (success) {
+		scaffold->shard_index = index;
+		scaffold->shard_count = count;
+	}
+	return success;
+}
+
+/** Save given query to scaffold.
+ *
+ * @param[in,out] scaffold
+ * @param[in] query Type of query
+ * @param[in] text Argument to the query, a position or a value
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int set_query(scaffolding * scaffold, query_type query, const char * text) {
+	if (scaffold->query != QUERY_NONE) {
+		report_parameter_error(PARAMETER_ERROR_QUERY_NOT_ALONE);
+		return 0;
+	}
+
+	if (query == QUERY_NTH) {
+		if (! parse_non_negative(text, &(scaffold->query_position))
+				|| (scaffold->query_position == 0)) {
+			report_parameter_error(PARAMETER_ERROR_INVALID_POSITION);
+			return 0;
+		}
+	} else {
+		char * end;
+		scaffold->query_value = strtod(text, &end);
+		if ((*text == '\0') || (*end != '\0') || is_nan_or_inf(scaffold->query_value)) {
+			report_parameter_error(PARAMETER_ERROR_INVALID_VALUE);
+			return 0;
+		}
+	}
+
+	scaffold->query = query;
+	return 1;
+}
+
+/** Save given ratio of a geometric sequence to scaffold.
+ *
+ * @param[in,out] scaffold
+ * @param[in] text Ratio, a positive number other than 1
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int set_ratio(scaffolding * scaffold, const char * text) {
+	char * end;
+	const double ratio = strtod(text, &end);
+
+	if ((*text == '\0') || (*end != '\0') || is_nan_or_inf(ratio)
+			|| (ratio <= 0) || (ratio == 1)) {
+		report_parameter_error(PARAMETER_ERROR_INVALID_RATIO);
+		return 0;
+	}
+
+	scaffold->ratio = ratio;
+	scaffold->flags |= FLAG_GEOMETRIC;
+	return 1;
+}
+
+/** Save given format of timestamps to scaffold.
+ *
+ * @param[in,out] scaffold
+ * @param[in] text Format with strftime-like fields, still escaped
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int set_time_format(scaffolding * scaffold, const char * text) {
+	char * const format = enum_strdup(text);
+	time_formatter formatter;
+	time_format_status status;
+
+	if (! format) {
+		report_parameter_error(PARAMETER_ERROR_OUT_OF_MEMORY);
+		return 0;
+	}
+	unescape(format, GUARD_PERCENT);
+
+	/* Reject unsupported fields right away */
+	status = time_formatter_init(&formatter, format);
+	if (status != TIME_FORMAT_SUCCESS) {
+		report_parameter_error((status == TIME_FORMAT_INVALID)
+			? PARAMETER_ERROR_INVALID_TIME_FORMAT
+			: PARAMETER_ERROR_OUT_OF_MEMORY);
+		free(format);
+		return 0;
+	}
+	time_formatter_free(&formatter);
+
+	free(scaffold->time_format);
+	scaffold->time_format = format;
+	scaffold->flags |= FLAG_TIME;
+	return 1;
+}
+
+/** Save given alphabet of words to scaffold.
+ *
+ * @param[in,out] scaffold
+ * @param[in] text Characters and ranges of characters like "a-z"
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int set_alphabet(scaffolding * scaffold, const char * text) {
+	char * alphabet;
+
+	switch (expand_alphabet(text, &alphabet)) {
+	case ALPHABET_SUCCESS:
+		break;
+	case ALPHABET_OUT_OF_MEMORY:
+		report_parameter_error(PARAMETER_ERROR_OUT_OF_MEMORY);
+		return 0;
+	case ALPHABET_INVERTED:
+		report_parameter_error(PARAMETER_ERROR_INVERTED_ALPHABET);
+		return 0;
+	default:
+		report_parameter_error(PARAMETER_ERROR_INVALID_ALPHABET);
+		return 0;
+	}
+
+	free(scaffold->alphabet);
+	scaffold->alphabet = alphabet;
+	return 1;
+}
+
+/** Save given kind of low-discrepancy sequence to scaffold.
+ *
+ * @param[in,out] scaffold
+ * @param[in] name One of "sobol", "halton" and "vdc"
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int set_quasi(scaffolding * scaffold, const char * name) {
+	static const struct {
+		const char * name;
+		quasi_type type;
+	} known[] = {
+		{"sobol",  QUASI_SOBOL},
+		{"halton", QUASI_HALTON},
+		{"vdc",    QUASI_VDC}
+	};
+	unsigned int i;
+
+	for (i = 0; i < sizeof(known) / sizeof(known[0]); i++) {
+		if (strcmp(known[i].name, name) == 0) {
+			scaffold->quasi.type = known[i].type;
+			return 1;
+		}
+	}
+
+	print_problem(USER_ERROR, "Unknown sequence \"%s\".", name);
+	return 0;
+}
+
+/** Save given kind of random walk to scaffold.
+ *
+ * @param[in,out] scaffold
+ * @param[in] name One of "step", "uniform" and "normal"
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int set_walk(scaffolding * scaffold, const char * name) {
+	static const struct {
+		const char * name;
+		walk_type type;
+	} known[] = {
+		{"step",    WALK_STEP},
+		{"uniform", WALK_UNIFORM},
+		{"normal",  WALK_NORMAL}
+	};
+	unsigned int i;
+
+	for (i = 0; i < sizeof(known) / sizeof(known[0]); i++) {
+		if (strcmp(known[i].name, name) == 0) {
+			scaffold->walk = known[i].type;
+			return 1;
+		}
+	}
+
+	print_problem(USER_ERROR, "Unknown kind of walk \"%s\".", name);
+	return 0;
+}
+
+/** Save given distribution of random values to scaffold.
+ *
+ * The specification consists of the name of a distribution, optionally
+ * followed by a colon and a comma-separated list of parameters,
+ * e.g. "normal:10,2.5".
+ *
+ * @param[in,out] scaffold
+ * @param[in] spec
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int set_distribution(scaffolding * scaffold, const char * spec) {
+	static const struct {
+		const char * name;
+		distribution_type type;
+		unsigned int max_argc;
+	} known[] = {
+		{"uniform",     DISTRIBUTION_UNIFORM,     0},
+		{"normal",      DISTRIBUTION_NORMAL,      2},
+		{"exponential", DISTRIBUTION_EXPONENTIAL, 1},
+		{"lognormal",   DISTRIBUTION_LOG_NORMAL,  2},
+		{"zipf",        DISTRIBUTION_ZIPF,        1}
+	};
+	const char * const colon = strchr(spec, ':');
+	const size_t name_len = colon ? (size_t)(colon - spec) : strlen(spec);
+	double args[MAX_DISTRIBUTION_ARGS];
+	unsigned int argc = 0;
+	unsigned int i;
+
+	for (i = 0; i < sizeof(known) / sizeof(known[0]); i++) {
+		if ((strlen(known[i].name) == name_len)
+				&& (strncmp(known[i].name, spec, name_len) == 0)) {
+			break;
+		}
+	}
+	if (i == sizeof(known) / sizeof(known[0])) {
+		print_problem(USER_ERROR, "Unknown distribution \"%s\".", spec);
+		return 0;
+	}
+
+	if (colon) {
+		const char * walker = colon + 1;
+		for (;;) {
+			char * end;
+			const double value = strtod(walker, &end);
+
+			if ((end == walker) || is_nan_or_inf(value)
+					|| (argc == known[i].max_argc)
+					|| ((*end != ',') && (*end != '\0'))) {
+				print_problem(USER_ERROR, "Invalid parameters for distribution \"%s\".", spec);
+				return 0;
+			}
+			args[argc++] = value;
+
+			if (*end == '\0') {
+				break;
+			}
+			walker = end + 1;
+		}
+	}
+
+	/* Scale parameters must be positive */
+	if (((known[i].type == DISTRIBUTION_EXPONENTIAL) && (argc >= 1) && (args[0] <= 0))
+			|| ((known[i].type == DISTRIBUTION_ZIPF) && (argc >= 1) && (args[0] <= 0))
+			|| ((known[i].type == DISTRIBUTION_NORMAL) && (argc >= 2) && (args[1] <= 0))
+			|| ((known[i].type == DISTRIBUTION_LOG_NORMAL) && (argc >= 2) && (args[1] <= 0))) {
+		print_problem(USER_ERROR, "Invalid parameters for distribution \"%s\".", spec);
+		return 0;
+	}
+
+	if (scaffold->distribution != DISTRIBUTION_UNIFORM) {
+		print_problem(WARNING, "Discarding previously specified distribution.");
+	}
+
+	scaffold->distribution = known[i].type;
+	scaffold->distribution_argc = argc;
+	for (i = 0; i < argc; i++) {
+		scaffold->distribution_args[i] = args[i];
+	}
+	return 1;
+}
+
+/** Save given order of tuples to scaffold.
+ *
+ * The specification consists of the name of an order, for "tiled"
+ * optionally followed by a colon and the tile size, e.g. "tiled:64".
+ *
+ * @param[in,out] scaffold
+ * @param[in] spec
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int set_order(scaffolding * scaffold, const char * spec) {
+	static const struct {
+		const char * name;
+		tuple_order order;
+	} known[] = {
+		{"row",     ORDER_ROW},
+		{"morton",  ORDER_MORTON},
+		{"hilbert", ORDER_HILBERT},
+		{"tiled",   ORDER_TILED}
+	};
+	const char * const colon = strchr(spec, ':');
+	const size_t name_len = colon ? (size_t)(colon - spec) : strlen(spec);
+	unsigned long tile_size = DEFAULT_TILE_SIZE;
+	unsigned int i;
+
+	for (i = 0; i < sizeof(known) / sizeof(known[0]); i++) {
+		if ((strlen(known[i].name) == name_len)
+				&& (strncmp(known[i].name, spec, name_len) == 0)) {
+			break;
+		}
+	}
+	if (i == sizeof(known) / sizeof(known[0])) {
+		print_problem(USER_ERROR, "Unknown order \"%s\".", spec);
+		return 0;
+	}
+
+	if (colon && ((known[i].order != ORDER_TILED)
+			|| ! parse_non_negative(colon + 1, &tile_size)
+			|| (tile_size == 0))) {
+		print_problem(USER_ERROR, "Invalid tile size for order \"%s\".", spec);
+		return 0;
+	}
+
+	scaffold->order = known[i].order;
+	scaffold->tile_size = tile_size;
+	return 1;
+}
+
+/** Check whether an argument marks a range of several as random.
+ *
+ * @param[in] arg
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+int is_random_range_marker(const char * arg) {
+	return ! strcmp(arg, "-r") || ! strcmp(arg, "--random");
+}
+
+/** Check whether any range of several is marked random.
+ *
+ * A range of several may start with -r|--random,
+ * e.g. "enum --zip 1 10 , -r 1 6".  With --concat, commas may be
+ * attached to neighbouring arguments, e.g. "enum --concat 1..10, -r 1..6".
+ *
+ * @param[in] argc
+ * @param[in] argv
+ * @param[in] first Index of the first argument after parameters
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int has_random_range(int argc, char ** argv, int first) {
+	int after_comma = 0;
+	int i;
+
+	for (i = first; i < argc; i++) {
+		const char * piece = argv[i];
+
+		for (;;) {
+			const char * const comma = strchr(piece, ',');
+			const size_t len = comma ? (size_t)(comma - piece) : strlen(piece);
+
+			if (len > 0) {
+				if (after_comma
+						&& (((len == 2) && ! strncmp(piece, "-r", len))
+							|| ((len == 8) && ! strncmp(piece, "--random", len)))) {
+					return 1;
+				}
+				after_comma = 0;
+			}
+			if (! comma) {
+				break;
+			}
+			after_comma = 1;
+			piece = comma + 1;
+		}
+	}
+	return 0;
+}
+
 /** @name Command line parsing */
 
 /*@{*/
@@ -733,6 +1252,9 @@ int parse_parameters(int original_argc, char **original_argv, scaffolding *dest)
 	int success = 1;
 	int quit = 0;
 	int ran_into_negative_number = 0;
+	int random;
+	int drawing;
+	int log_spaced = 0;
 
 	/* Inhibit getopt's own error message for unrecognized options */
 	opterr = 0;
@@ -755,12 +1277,57 @@ int parse_parameters(int original_argc, char **original_argv, scaffolding *dest)
 			{"equal-width",  no_argument,       0, 'e'},
 			{"null",         no_argument,       0, 'z'},
 			{"zero",         no_argument,       0, 'z'},
+			{"distribution", required_argument, 0, OPTION_DISTRIBUTION},
+			{"secure",       no_argument,       0, OPTION_SECURE},
+			{"skip",         required_argument, 0, OPTION_SKIP},
+			{"limit",        required_argument, 0, OPTION_LIMIT},
+			{"shard",        required_argument, 0, OPTION_SHARD},
+			{"chunks",       required_argument, 0, OPTION_CHUNKS},
+			{"align",        required_argument, 0, OPTION_ALIGN},
+			{"nth",          required_argument, 0, OPTION_NTH},
+			{"index-of",     required_argument, 0, OPTION_INDEX_OF},
+			{"contains",     required_argument, 0, OPTION_CONTAINS},
+			{"sum",          no_argument,       0, OPTION_SUM},
+			{"count",        no_argument,       0, OPTION_COUNT},
+			{"min",          no_argument,       0, OPTION_MIN},
+			{"max",          no_argument,       0, OPTION_MAX},
+			{"mean",         no_argument,       0, OPTION_MEAN},
+			{"reverse",      no_argument,       0, OPTION_REVERSE},
+			{"predict-size", no_argument,       0, OPTION_PREDICT_SIZE},
+			{"digest",       no_argument,       0, OPTION_DIGEST},
+			{"verify",       required_argument, 0, OPTION_VERIFY},
+			{"field-separator", required_argument, 0, OPTION_FIELD_SEPARATOR},
+			{"field-format", required_argument, 0, OPTION_FIELD_FORMAT},
+			{"order",        required_argument, 0, OPTION_ORDER},
+			{"zip",          no_argument,       0, OPTION_ZIP},
+			{"concat",       no_argument,       0, OPTION_CONCAT},
+			{"union",        no_argument,       0, OPTION_UNION},
+			{"intersection", no_argument,       0, OPTION_INTERSECTION},
+			{"geometric",    required_argument, 0, OPTION_GEOMETRIC},
+			{"log-spaced",   no_argument,       0, OPTION_LOG_SPACED},
+			{"time",         optional_argument, 0, OPTION_TIME},
+			{"alphabet",     required_argument, 0, OPTION_ALPHABET},
+			{"primes",       no_argument,       0, OPTION_PRIMES},
+			{"quasi",        required_argument, 0, OPTION_QUASI},
+			{"from-stdin",   no_argument,       0, OPTION_FROM_STDIN},
+			{"number-lines", no_argument,       0, OPTION_NUMBER_LINES},
+			{"random-string", required_argument, 0, OPTION_RANDOM_STRING},
+			{"choose-from",  required_argument, 0, OPTION_CHOOSE_FROM},
+			{"weights",      required_argument, 0, OPTION_WEIGHTS},
+			{"walk",         optional_argument, 0, OPTION_WALK},
 			{0, 0, 0, 0}
 		};
 
 		/* Backup optind value _before_ call to getopt_long */
 		const int guilty_index = (optind > 0) ? optind : 1;
 
+		/* First of several ranges marked --except? */
+		if ((guilty_index < original_argc)
+				&& ! strcmp(original_argv[guilty_index], "--except")) {
+			optind = guilty_index;
+			break;
+		}
+
 		c = getopt_long(original_argc, original_argv, "+b:cef:hi:lnp:rs:t:Vw:z", long_options, &option_index);
 
 		if (c == -1) {
@@ -936,6 +1503,231 @@ int parse_parameters(int original_argc, char **original_argv, scaffolding *dest)
 			set_separator(dest, NULL, APPLY_NULL_BYTES);
 			break;
 
+		case OPTION_DISTRIBUTION:
+			if (! set_distribution(dest, optarg)) {
+				success = 0;
+			}
+			break;
+
+		case OPTION_SECURE:
+			dest->flags |= FLAG_SECURE;
+			break;
+
+		case OPTION_SKIP:
+			if (! parse_non_negative(optarg, &(dest->skip))) {
+				report_parameter_error(PARAMETER_ERROR_INVALID_SKIP);
+				success = 0;
+			}
+			break;
+
+		case OPTION_LIMIT:
+			if (! parse_non_negative(optarg, &(dest->limit))) {
+				report_parameter_error(PARAMETER_ERROR_INVALID_LIMIT);
+				success = 0;
+				break;
+			}
+			dest->flags |= FLAG_LIMIT_SET;
+			break;
+
+		case OPTION_SHARD:
+			if (! set_shard(dest, optarg)) {
+				report_parameter_error(PARAMETER_ERROR_INVALID_SHARD);
+				success = 0;
+			}
+			break;
+
+		case OPTION_CHUNKS:
+			if (! parse_non_negative(optarg, &(dest->chunk_count))
+					|| (dest->chunk_count == 0)) {
+				report_parameter_error(PARAMETER_ERROR_INVALID_CHUNKS);
+				success = 0;
+			}
+			break;
+
+		case OPTION_ALIGN:
+			if (! parse_non_negative(optarg, &(dest->chunk_align))
+					|| (dest->chunk_align == 0)) {
+				report_parameter_error(PARAMETER_ERROR_INVALID_ALIGN);
+				success = 0;
+			}
+			break;
+
+		case OPTION_NTH:
+			if (! set_query(dest, QUERY_NTH, optarg)) {
+				success = 0;
+			}
+			break;
+
+		case OPTION_INDEX_OF:
+			if (! set_query(dest, QUERY_INDEX_OF, optarg)) {
+				success = 0;
+			}
+			break;
+
+		case OPTION_CONTAINS:
+			if (! set_query(dest, QUERY_CONTAINS, optarg)) {
+				success = 0;
+			}
+			break;
+
+		case OPTION_SUM:
+			dest->aggregates |= AGGREGATE_SUM;
+			break;
+
+		case OPTION_COUNT:
+			dest->aggregates |= AGGREGATE_COUNT;
+			break;
+
+		case OPTION_MIN:
+			dest->aggregates |= AGGREGATE_MIN;
+			break;
+
+		case OPTION_MAX:
+			dest->aggregates |= AGGREGATE_MAX;
+			break;
+
+		case OPTION_MEAN:
+			dest->aggregates |= AGGREGATE_MEAN;
+			break;
+
+		case OPTION_REVERSE:
+			dest->flags |= FLAG_REVERSE;
+			break;
+
+		case OPTION_PREDICT_SIZE:
+			dest->flags |= FLAG_PREDICT_SIZE;
+			break;
+
+		case OPTION_DIGEST:
+			dest->flags |= FLAG_DIGEST;
+			break;
+
+		case OPTION_FIELD_SEPARATOR:
+			free(dest->field_separator);
+			dest->field_separator = enum_strdup(optarg);
+			if (! dest->field_separator) {
+				report_parameter_error(PARAMETER_ERROR_OUT_OF_MEMORY);
+				success = 0;
+				break;
+			}
+			unescape(dest->field_separator, GUARD_PERCENT);
+			break;
+
+		case OPTION_FIELD_FORMAT:
+			if (! analyze_format(optarg)) {
+				success = 0;
+				break;
+			}
+			if (! add_field_format(dest, optarg)) {
+				report_parameter_error(PARAMETER_ERROR_OUT_OF_MEMORY);
+				success = 0;
+			}
+			break;
+
+		case OPTION_ORDER:
+			if (! set_order(dest, optarg)) {
+				success = 0;
+			}
+			break;
+
+		case OPTION_ZIP:
+			dest->flags |= FLAG_ZIP;
+			break;
+
+		case OPTION_CONCAT:
+			dest->flags |= FLAG_CONCAT;
+			break;
+
+		case OPTION_UNION:
+			dest->operation = SET_UNION;
+			break;
+
+		case OPTION_INTERSECTION:
+			dest->operation = SET_INTERSECTION;
+			break;
+
+		case OPTION_GEOMETRIC:
+			if (! set_ratio(dest, optarg)) {
+				success = 0;
+			}
+			break;
+
+		case OPTION_LOG_SPACED:
+			dest->flags |= FLAG_GEOMETRIC;
+			log_spaced = 1;
+			break;
+
+		case OPTION_ALPHABET:
+			if (! set_alphabet(dest, optarg)) {
+				success = 0;
+			}
+			break;
+
+		case OPTION_PRIMES:
+			dest->flags |= FLAG_PRIMES;
+			break;
+
+		case OPTION_QUASI:
+			if (! set_quasi(dest, optarg)) {
+				success = 0;
+			}
+			break;
+
+		case OPTION_FROM_STDIN:
+			dest->flags |= FLAG_FROM_STDIN;
+			break;
+
+		case OPTION_NUMBER_LINES:
+			dest->flags |= FLAG_NUMBER_LINES;
+			break;
+
+		case OPTION_RANDOM_STRING:
+			if (! parse_non_negative(optarg, &(dest->string_length))
+					|| (dest->string_length == 0)) {
+				report_parameter_error(PARAMETER_ERROR_INVALID_STRING_LENGTH);
+				success = 0;
+			}
+			break;
+
+		case OPTION_TIME:
+			if (! set_time_format(dest, optarg ? optarg : DEFAULT_TIME_FORMAT)) {
+				success = 0;
+			}
+			break;
+
+		case OPTION_CHOOSE_FROM:
+			free(dest->choice_file);
+			dest->choice_file = enum_strdup(optarg);
+			if (! dest->choice_file) {
+				report_parameter_error(PARAMETER_ERROR_OUT_OF_MEMORY);
+				success = 0;
+			}
+			break;
+
+		case OPTION_WEIGHTS:
+			free(dest->weights_file);
+			dest->weights_file = enum_strdup(optarg);
+			if (! dest->weights_file) {
+				report_parameter_error(PARAMETER_ERROR_OUT_OF_MEMORY);
+				success = 0;
+			}
+			break;
+
+		case OPTION_WALK:
+			if (! set_walk(dest, optarg ? optarg : "step")) {
+				success = 0;
+			}
+			break;
+
+		case OPTION_VERIFY:
+			free(dest->verify_file);
+			dest->verify_file = enum_strdup(optarg);
+			if (! dest->verify_file) {
+				report_parameter_error(PARAMETER_ERROR_OUT_OF_MEMORY);
+				success = 0;
+			}
+			break;
+
 		case '?':
 			/* Use is_number to see if this unknown parameter actually is an argument, like '-2' */
 			if (is_number(original_argv[guilty_index])) {
@@ -958,13 +1750,305 @@ int parse_parameters(int original_argc, char **original_argv, scaffolding *dest)
 		success = 0;
 	}
 
+	/* Random values wanted, possibly for some of several ranges only? */
+	random = CHECK_FLAG(dest->flags, FLAG_RANDOM)
+		|| has_random_range(original_argc, original_argv, optind);
+
+	/* Random numbers drawn for anything at all? */
+	drawing = random || (dest->string_length > 0) || dest->choice_file
+		|| (dest->walk != WALK_NONE);
+
 	/* Seed given without random flag? */
-	if (CHECK_FLAG(dest->flags, FLAG_USER_SEED)
-			&& ! CHECK_FLAG(dest->flags, FLAG_RANDOM)) {
-		print_problem(USER_ERROR, "Parameter -i|--seed=NUMBER requires -r|--random.");
+	if (CHECK_FLAG(dest->flags, FLAG_USER_SEED) && ! drawing) {
+		print_problem(USER_ERROR, "Parameter -i|--seed=NUMBER requires -r|--random, --random-string=LENGTH, --choose-from=FILE or --walk[=KIND].");
+		success = 0;
+	}
+
+	/* Distribution given without random flag? */
+	if ((dest->distribution != DISTRIBUTION_UNIFORM) && ! random) {
+		print_problem(USER_ERROR, "Parameter --distribution=NAME requires -r|--random.");
+		success = 0;
+	}
+
+	/* Secure mode without random flag or with fixed seed? */
+	if (CHECK_FLAG(dest->flags, FLAG_SECURE)) {
+		if (! drawing) {
+			print_problem(USER_ERROR, "Parameter --secure requires -r|--random, --random-string=LENGTH, --choose-from=FILE or --walk[=KIND].");
+			success = 0;
+		} else if (CHECK_FLAG(dest->flags, FLAG_USER_SEED)) {
+			print_problem(USER_ERROR, "Combining --secure and -i|--seed=NUMBER not supported.");
+			success = 0;
+		}
+	}
+
+	/* Skipping random values? */
+	if ((dest->skip > 0) && CHECK_FLAG(dest->flags, FLAG_RANDOM)) {
+		print_problem(USER_ERROR, "Combining --skip and -r|--random not supported.");
+		success = 0;
+	}
+
+	/* Positions past the window need to fit into an unsigned long */
+	if (CHECK_FLAG(dest->flags, FLAG_LIMIT_SET) && (dest->limit > ULONG_MAX - dest->skip)) {
+		print_problem(USER_ERROR, "Sum of --skip=COUNT and --limit=COUNT exceeds %lu.", ULONG_MAX);
+		success = 0;
+	}
+
+	/* Sharding random values? */
+	if ((dest->shard_count > 0) && CHECK_FLAG(dest->flags, FLAG_RANDOM)) {
+		print_problem(USER_ERROR, "Combining --shard and -r|--random not supported.");
+		success = 0;
+	}
+
+	/* Chunks of random values or chunks of a shard? */
+	if (dest->chunk_count > 0) {
+		if (CHECK_FLAG(dest->flags, FLAG_RANDOM)) {
+			print_problem(USER_ERROR, "Combining --chunks and -r|--random not supported.");
+			success = 0;
+		} else if (dest->shard_count > 0) {
+			print_problem(USER_ERROR, "Combining --chunks and --shard not supported.");
+			success = 0;
+		}
+	} else if (dest->chunk_align != 1) {
+		print_problem(USER_ERROR, "Parameter --align=COUNT requires --chunks=COUNT.");
+		success = 0;
+	}
+
+	/* Queries on random values, shards or chunks? */
+	if (dest->query != QUERY_NONE) {
+		if (CHECK_FLAG(dest->flags, FLAG_RANDOM)) {
+			print_problem(USER_ERROR, "Combining --nth, --index-of or --contains and -r|--random not supported.");
+			success = 0;
+		} else if ((dest->shard_count > 0) || (dest->chunk_count > 0)) {
+			print_problem(USER_ERROR, "Combining --nth, --index-of or --contains and --shard or --chunks not supported.");
+			success = 0;
+		}
+	}
+
+	/* Reversing random values? */
+	if (CHECK_FLAG(dest->flags, FLAG_REVERSE) && CHECK_FLAG(dest->flags, FLAG_RANDOM)) {
+		print_problem(USER_ERROR, "Combining --reverse and -r|--random not supported.");
 		success = 0;
 	}
 
+	/* Aggregates of something else than values? */
+	if ((dest->aggregates != 0) && ((dest->query != QUERY_NONE)
+			|| (dest->shard_count > 0) || (dest->chunk_count > 0))) {
+		print_problem(USER_ERROR, "Combining aggregates and --shard, --chunks or queries not supported.");
+		success = 0;
+	}
+
+	/* Predicting size of output other than values? */
+	if (CHECK_FLAG(dest->flags, FLAG_PREDICT_SIZE)) {
+		if (CHECK_FLAG(dest->flags, FLAG_RANDOM)) {
+			print_problem(USER_ERROR, "Combining --predict-size and -r|--random not supported.");
+			success = 0;
+		} else if ((dest->chunk_count > 0) || (dest->query != QUERY_NONE)
+				|| (dest->aggregates != 0)) {
+			print_problem(USER_ERROR, "Combining --predict-size and --chunks, queries or aggregates not supported.");
+			success = 0;
+		}
+	}
+
+	/* Geometric random values? */
+	if (CHECK_FLAG(dest->flags, FLAG_GEOMETRIC)) {
+		if (random) {
+			print_problem(USER_ERROR, "Combining --geometric=RATIO or --log-spaced and -r|--random not supported.");
+			success = 0;
+		} else if ((dest->ratio != 0) && log_spaced) {
+			print_problem(USER_ERROR, "Combining --geometric=RATIO and --log-spaced not supported.");
+			success = 0;
+		}
+	}
+
+	/* Timestamps of anything but plain values? */
+	if (CHECK_FLAG(dest->flags, FLAG_TIME)) {
+		if (random || CHECK_FLAG(dest->flags, FLAG_GEOMETRIC)) {
+			print_problem(USER_ERROR, "Combining --time and -r|--random, --geometric=RATIO or --log-spaced not supported.");
+			success = 0;
+		} else if (dest->format || CHECK_FLAG(dest->flags, FLAG_EQUAL_WIDTH)
+				|| CHECK_FLAG(dest->flags, FLAG_USER_PRECISION)) {
+			print_problem(USER_ERROR, "Combining --time and -f|--format, -b|--dumb, -c|--characters, -e|--equal-width or -p|--precision not supported.");
+			success = 0;
+		} else if ((dest->chunk_count > 0) || (dest->query != QUERY_NONE)
+				|| (dest->aggregates != 0)
+				|| CHECK_FLAG(dest->flags, FLAG_PREDICT_SIZE)) {
+			print_problem(USER_ERROR, "Combining --time and --chunks, queries, aggregates or --predict-size not supported.");
+			success = 0;
+		}
+	}
+
+	/* Random strings rather than values? */
+	if (dest->string_length > 0) {
+		if (random || (dest->quasi.type != QUASI_NONE)
+				|| CHECK_FLAG(dest->flags, FLAG_GEOMETRIC)
+				|| CHECK_FLAG(dest->flags, FLAG_TIME) || CHECK_FLAG(dest->flags, FLAG_PRIMES)
+				|| CHECK_FLAG(dest->flags, FLAG_FROM_STDIN)
+				|| CHECK_FLAG(dest->flags, FLAG_NUMBER_LINES)) {
+			print_problem(USER_ERROR, "Combining --random-string=LENGTH and -r|--random, --quasi=NAME, --geometric=RATIO, --log-spaced, --time, --primes, --from-stdin or --number-lines not supported.");
+			success = 0;
+		} else if (dest->format || CHECK_FLAG(dest->flags, FLAG_EQUAL_WIDTH)
+				|| CHECK_FLAG(dest->flags, FLAG_USER_PRECISION)) {
+			print_problem(USER_ERROR, "Combining --random-string=LENGTH and -f|--format, -b|--dumb, -c|--characters, -e|--equal-width or -p|--precision not supported.");
+			success = 0;
+		} else if ((dest->shard_count > 0) || (dest->chunk_count > 0)
+				|| (dest->query != QUERY_NONE) || (dest->aggregates != 0)
+				|| CHECK_FLAG(dest->flags, FLAG_PREDICT_SIZE)) {
+			print_problem(USER_ERROR, "Combining --random-string=LENGTH and --shard, --chunks, queries, aggregates or --predict-size not supported.");
+			success = 0;
+		}
+
+		/* Characters of --alphabet=CHARS make up strings rather than words */
+		dest->string_alphabet = dest->alphabet;
+		dest->alphabet = NULL;
+		if (! dest->string_alphabet
+				&& (expand_alphabet(DEFAULT_STRING_ALPHABET, &(dest->string_alphabet))
+					!= ALPHABET_SUCCESS)) {
+			report_parameter_error(PARAMETER_ERROR_OUT_OF_MEMORY);
+			success = 0;
+		}
+	}
+
+	/* Random lines of a file rather than values? */
+	if (dest->choice_file) {
+		if (random || (dest->quasi.type != QUASI_NONE)
+				|| CHECK_FLAG(dest->flags, FLAG_GEOMETRIC)
+				|| CHECK_FLAG(dest->flags, FLAG_TIME) || dest->alphabet
+				|| CHECK_FLAG(dest->flags, FLAG_PRIMES)
+				|| CHECK_FLAG(dest->flags, FLAG_FROM_STDIN)
+				|| CHECK_FLAG(dest->flags, FLAG_NUMBER_LINES)
+				|| (dest->string_length > 0)) {
+			print_problem(USER_ERROR, "Combining --choose-from=FILE and -r|--random, --quasi=NAME, --geometric=RATIO, --log-spaced, --time, --alphabet=CHARS, --primes, --from-stdin, --number-lines or --random-string=LENGTH not supported.");
+			success = 0;
+		} else if (dest->format || CHECK_FLAG(dest->flags, FLAG_EQUAL_WIDTH)
+				|| CHECK_FLAG(dest->flags, FLAG_USER_PRECISION)) {
+			print_problem(USER_ERROR, "Combining --choose-from=FILE and -f|--format, -b|--dumb, -c|--characters, -e|--equal-width or -p|--precision not supported.");
+			success = 0;
+		} else if ((dest->shard_count > 0) || (dest->chunk_count > 0)
+				|| (dest->query != QUERY_NONE) || (dest->aggregates != 0)
+				|| CHECK_FLAG(dest->flags, FLAG_PREDICT_SIZE)) {
+			print_problem(USER_ERROR, "Combining --choose-from=FILE and --shard, --chunks, queries, aggregates or --predict-size not supported.");
+			success = 0;
+		}
+	} else if (dest->weights_file) {
+		print_problem(USER_ERROR, "Parameter --weights=FILE requires --choose-from=FILE.");
+		success = 0;
+	}
+
+	/* Random walk rather than plain values? */
+	if (dest->walk != WALK_NONE) {
+		if (random || (dest->quasi.type != QUASI_NONE)
+				|| CHECK_FLAG(dest->flags, FLAG_GEOMETRIC)
+				|| CHECK_FLAG(dest->flags, FLAG_TIME) || dest->alphabet
+				|| CHECK_FLAG(dest->flags, FLAG_PRIMES)
+				|| CHECK_FLAG(dest->flags, FLAG_FROM_STDIN)
+				|| CHECK_FLAG(dest->flags, FLAG_NUMBER_LINES)
+				|| (dest->string_length > 0) || dest->choice_file) {
+			print_problem(USER_ERROR, "Combining --walk[=KIND] and -r|--random, --quasi=NAME, --geometric=RATIO, --log-spaced, --time, --alphabet=CHARS, --primes, --from-stdin, --number-lines, --random-string=LENGTH or --choose-from=FILE not supported.");
+			success = 0;
+		} else if (CHECK_FLAG(dest->flags, FLAG_EQUAL_WIDTH)
+				|| CHECK_FLAG(dest->flags, FLAG_REVERSE) || (dest->skip > 0)) {
+			print_problem(USER_ERROR, "Combining --walk[=KIND] and -e|--equal-width, --reverse or --skip not supported.");
+			success = 0;
+		} else if ((dest->shard_count > 0) || (dest->chunk_count > 0)
+				|| (dest->query != QUERY_NONE) || (dest->aggregates != 0)
+				|| CHECK_FLAG(dest->flags, FLAG_PREDICT_SIZE)) {
+			print_problem(USER_ERROR, "Combining --walk[=KIND] and --shard, --chunks, queries, aggregates or --predict-size not supported.");
+			success = 0;
+		}
+	}
+
+	/* Words of anything but plain values? */
+	if (dest->alphabet) {
+		if (CHECK_FLAG(dest->flags, FLAG_TIME) || CHECK_FLAG(dest->flags, FLAG_GEOMETRIC)) {
+			print_problem(USER_ERROR, "Combining --alphabet=CHARS and --time, --geometric=RATIO or --log-spaced not supported.");
+			success = 0;
+		} else if (dest->format || CHECK_FLAG(dest->flags, FLAG_EQUAL_WIDTH)
+				|| CHECK_FLAG(dest->flags, FLAG_USER_PRECISION)) {
+			print_problem(USER_ERROR, "Combining --alphabet=CHARS and -f|--format, -b|--dumb, -c|--characters, -e|--equal-width or -p|--precision not supported.");
+			success = 0;
+		} else if ((dest->chunk_count > 0) || (dest->query != QUERY_NONE)
+				|| (dest->aggregates != 0)
+				|| CHECK_FLAG(dest->flags, FLAG_PREDICT_SIZE)) {
+			print_problem(USER_ERROR, "Combining --alphabet=CHARS and --chunks, queries, aggregates or --predict-size not supported.");
+			success = 0;
+		}
+	}
+
+	/* Reformatting numbers from stdin with options about ranges? */
+	if (CHECK_FLAG(dest->flags, FLAG_FROM_STDIN)) {
+		if (random || (dest->quasi.type != QUASI_NONE)
+				|| CHECK_FLAG(dest->flags, FLAG_GEOMETRIC)
+				|| CHECK_FLAG(dest->flags, FLAG_TIME) || dest->alphabet
+				|| CHECK_FLAG(dest->flags, FLAG_PRIMES)
+				|| CHECK_FLAG(dest->flags, FLAG_EQUAL_WIDTH)) {
+			print_problem(USER_ERROR, "Combining --from-stdin and -r|--random, --quasi=NAME, --geometric=RATIO, --log-spaced, --time, --alphabet=CHARS, --primes or -e|--equal-width not supported.");
+			success = 0;
+		} else if (CHECK_FLAG(dest->flags, FLAG_REVERSE) || (dest->shard_count > 0)
+				|| (dest->chunk_count > 0) || (dest->query != QUERY_NONE)
+				|| (dest->aggregates != 0)
+				|| CHECK_FLAG(dest->flags, FLAG_PREDICT_SIZE)) {
+			print_problem(USER_ERROR, "Combining --from-stdin and --reverse, --shard, --chunks, queries, aggregates or --predict-size not supported.");
+			success = 0;
+		}
+	}
+
+	/* Numbering lines with anything but values printed one by one? */
+	if (CHECK_FLAG(dest->flags, FLAG_NUMBER_LINES)) {
+		if (CHECK_FLAG(dest->flags, FLAG_FROM_STDIN)
+				|| CHECK_FLAG(dest->flags, FLAG_TIME) || dest->alphabet
+				|| CHECK_FLAG(dest->flags, FLAG_PRIMES)) {
+			print_problem(USER_ERROR, "Combining --number-lines and --from-stdin, --time, --alphabet=CHARS or --primes not supported.");
+			success = 0;
+		} else if ((dest->shard_count > 0) || (dest->chunk_count > 0)
+				|| (dest->query != QUERY_NONE) || (dest->aggregates != 0)
+				|| CHECK_FLAG(dest->flags, FLAG_PREDICT_SIZE)) {
+			print_problem(USER_ERROR, "Combining --number-lines and --shard, --chunks, queries, aggregates or --predict-size not supported.");
+			success = 0;
+		}
+	}
+
+	/* Low-discrepancy values where random values or positions do not fit? */
+	if (dest->quasi.type != QUASI_NONE) {
+		if (random || CHECK_FLAG(dest->flags, FLAG_GEOMETRIC)
+				|| CHECK_FLAG(dest->flags, FLAG_PRIMES)) {
+			print_problem(USER_ERROR, "Combining --quasi=NAME and -r|--random, --geometric=RATIO, --log-spaced or --primes not supported.");
+			success = 0;
+		} else if (CHECK_FLAG(dest->flags, FLAG_REVERSE) || (dest->chunk_count > 0)
+				|| (dest->query != QUERY_NONE)
+				|| CHECK_FLAG(dest->flags, FLAG_PREDICT_SIZE)) {
+			print_problem(USER_ERROR, "Combining --quasi=NAME and --reverse, --chunks, queries or --predict-size not supported.");
+			success = 0;
+		}
+	}
+
+	/* Primes among anything but plain sequential values? */
+	if (CHECK_FLAG(dest->flags, FLAG_PRIMES)) {
+		if (random || CHECK_FLAG(dest->flags, FLAG_GEOMETRIC)
+				|| CHECK_FLAG(dest->flags, FLAG_TIME) || dest->alphabet) {
+			print_problem(USER_ERROR, "Combining --primes and -r|--random, --geometric=RATIO, --log-spaced, --time or --alphabet=CHARS not supported.");
+			success = 0;
+		} else if ((dest->skip > 0) || (dest->shard_count > 0)
+				|| (dest->chunk_count > 0) || (dest->query != QUERY_NONE)
+				|| (dest->aggregates != 0)
+				|| CHECK_FLAG(dest->flags, FLAG_PREDICT_SIZE)) {
+			print_problem(USER_ERROR, "Combining --primes and --skip, --shard, --chunks, queries, aggregates or --predict-size not supported.");
+			success = 0;
+		}
+	}
+
+	/* Hashing or verifying output other than values? */
+	if (CHECK_FLAG(dest->flags, FLAG_DIGEST) || dest->verify_file) {
+		if (CHECK_FLAG(dest->flags, FLAG_DIGEST) && dest->verify_file) {
+			print_problem(USER_ERROR, "Combining --digest and --verify=FILE not supported.");
+			success = 0;
+		} else if ((dest->chunk_count > 0) || (dest->query != QUERY_NONE)
+				|| (dest->aggregates != 0)
+				|| CHECK_FLAG(dest->flags, FLAG_PREDICT_SIZE)) {
+			print_problem(USER_ERROR, "Combining --digest or --verify=FILE and --chunks, queries, aggregates or --predict-size not supported.");
+			success = 0;
+		}
+	}
+
 	return success
 		? (quit
 			? 0
@@ -46,6 +46,6 @@ int preparse_args(int reduced_argc, char ** reduced_argv,
 		int * new_argc, char *** new_argv);
 int parse_args(int reduced_argc, char **reduced_argv, scaffolding *dest);
 int parse_parameters(int original_argc, char **original_argv, scaffolding *dest);
-int make_default_format_string(scaffolding *dest, unsigned int precision);
+int is_random_range_marker(const char * arg);
 
 #endif /* PARSING_H */
@@ -0,0 +1,139 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "prediction.h"
+#include "printing.h"
+
+#include <math.h>  /* for fabs */
+
+/** Tells the class of magnitude a value belongs to
+ *
+ * Within a class, printed length only grows with the distance from the
+ * class border, see is_length_monotone_format().
+ *
+ * @param[in] value
+ *
+ * @return class, 0 to 3
+ *
+ * @since 1.2
+ */
+static int magnitude_class(double value) {
+	return ((value < 0) ? 0 : 2) + ((fabs(value) >= 1) ? 1 : 0);
+}
+
+/** Checks whether a value is in the same length band as another value
+ *
+ * @param[in] scaffold Completed scaffold
+ * @param[in] position Position of the value to check, relative to skip
+ * @param[in] length Printed length of the other value
+ * @param[in] class Class of magnitude of the other value
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int is_in_band(scaffolding const * scaffold, unsigned long position,
+		size_t length, int class) {
+	const double value = value_at_position(scaffold, scaffold->skip + position);
+	size_t value_length;
+
+	multi_printf_length(scaffold->format, value, &value_length);
+	return (value_length == length) && (magnitude_class(value) == class);
+}
+
+/** Adds up the printed length of all values selected
+ *
+ * Values are walked band by band, a band being a run of values with the
+ * same printed length, e.g. all values with three digits.  The end of a
+ * band is found by galloping ahead and bisecting the last gap, so the
+ * cost is logarithmic per band.  For formats that print lengths not
+ * growing with magnitude, every value forms a band of its own.
+ *
+ * @param[in] scaffold Completed scaffold
+ * @param[in] window Number of values selected
+ *
+ * @return Number of bytes
+ *
+ * @since 1.2
+ */
+double count_value_bytes(scaffolding const * scaffold, unsigned long window) {
+	const int monotone = is_length_monotone_format(scaffold->format);
+	unsigned long first = 0;
+	double bytes = 0;
+
+	while (first < window) {
+		const double value = value_at_position(scaffold, scaffold->skip + first);
+		const int class = magnitude_class(value);
+		unsigned long last = first;
+		unsigned long beyond = window;
+		size_t length;
+
+		multi_printf_length(scaffold->format, value, &length);
+
+		if (monotone) {
+			unsigned long jump = 1;
+
+			while (last < window - 1) {
+				const unsigned long probe = (jump < window - 1 - last)
+					? last + jump
+					: window - 1;
+				if (! is_in_band(scaffold, probe, length, class)) {
+					beyond = probe;
+					break;
+				}
+				last = probe;
+				jump *= 2;
+			}
+
+			while ((beyond < window) && (beyond - last > 1)) {
+				const unsigned long middle = last + (beyond - last) / 2;
+				if (is_in_band(scaffold, middle, length, class)) {
+					last = middle;
+				} else {
+					beyond = middle;
+				}
+			}
+		}
+
+		bytes += (double)(last - first + 1) * length;
+		first = last + 1;
+	}
+
+	return bytes;
+}
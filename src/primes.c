@@ -0,0 +1,258 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "primes.h"
+
+#include <stdlib.h>  /* for malloc */
+#include <string.h>  /* for memset */
+#include <math.h>    /* for floor, sqrt */
+
+/** Residues coprime to 30, one per bit of a segment byte */
+static const unsigned char wheel_residues[8] = {1, 7, 11, 13, 17, 19, 23, 29};
+
+/** Bit of each residue modulo 30, -1 for multiples of 2, 3 or 5 */
+static const signed char wheel_bits[30] = {
+	-1,  0, -1, -1, -1, -1, -1,  1, -1, -1,
+	-1,  2, -1,  3, -1, -1, -1,  4, -1,  5,
+	-1, -1, -1,  6, -1, -1, -1, -1, -1,  7
+};
+
+/** Inverse of each residue coprime to 30, modulo 30 */
+static const unsigned char wheel_inverses[30] = {
+	0,  1, 0, 0, 0, 0, 0, 13, 0, 0,
+	0, 11, 0, 7, 0, 0, 0, 23, 0, 19,
+	0,  0, 0, 17, 0, 0, 0,  0, 0, 29
+};
+
+/** Prepare a sieve
+ *
+ * @param[out] sieve
+ *
+ * @return zero if out of memory, non-zero otherwise
+ *
+ * @since 1.2
+ */
+int prime_sieve_init(prime_sieve * sieve) {
+	sieve->base_primes = NULL;
+	sieve->base_count = 0;
+	sieve->base_limit = 0;
+	sieve->low = 0;
+	sieve->valid = 0;
+	sieve->segment = (unsigned char *)malloc(PRIME_SEGMENT_BYTES);
+	return sieve->segment != NULL;
+}
+
+/** Make sure base primes up to a given bound are known
+ *
+ * Base primes are found with a plain sieve over odd numbers, sieving
+ * at least twice as far as before to keep the number of runs low.
+ *
+ * @param[in,out] sieve
+ * @param[in] limit
+ *
+ * @return zero if out of memory, non-zero otherwise
+ *
+ * @since 1.2
+ */
+static int ensure_base_primes(prime_sieve * sieve, unsigned long limit) {
+	unsigned char * composite;
+	unsigned long * primes;
+	unsigned long count = 0;
+	unsigned long odd_count;
+	unsigned long i;
+
+	if (limit <= sieve->base_limit) {
+		return 1;
+	}
+	if (limit < 2 * sieve->base_limit) {
+		limit = 2 * sieve->base_limit;
+	}
+
+	/* Index i stands for 2 * i + 1 */
+	odd_count = limit / 2 + 1;
+	composite = (unsigned char *)malloc(odd_count);
+	if (! composite) {
+		return 0;
+	}
+	memset(composite, 0, odd_count);
+	for (i = 1; (2 * i + 1) * (2 * i + 1) <= limit; i++) {
+		if (! composite[i]) {
+			const unsigned long p = 2 * i + 1;
+			unsigned long j;
+			for (j = p * p / 2; j < odd_count; j += p) {
+				composite[j] = 1;
+			}
+		}
+	}
+
+	for (i = 3; i < odd_count; i++) {
+		count += ! composite[i] && (2 * i + 1 <= limit);
+	}
+	primes = (unsigned long *)malloc((count + 1) * sizeof(unsigned long));
+	if (! primes) {
+		free(composite);
+		return 0;
+	}
+	count = 0;
+	for (i = 3; i < odd_count; i++) {
+		if (! composite[i] && (2 * i + 1 <= limit)) {
+			primes[count++] = 2 * i + 1;
+		}
+	}
+	free(composite);
+
+	free(sieve->base_primes);
+	sieve->base_primes = primes;
+	sieve->base_count = count;
+	sieve->base_limit = limit;
+	return 1;
+}
+
+/** Sieve the segment starting at a given number
+ *
+ * For each base prime p, the multiples p * k with k coprime to 30 fall
+ * into eight residue classes modulo 30, each a progression of step 30p.
+ * Crossing off starts at p * p, smaller multiples having smaller factors.
+ *
+ * @param[in,out] sieve
+ * @param[in] low Multiple of PRIME_SEGMENT_SPAN
+ *
+ * @since 1.2
+ */
+static void sieve_segment(prime_sieve * sieve, unsigned long low) {
+	const unsigned long high = low + PRIME_SEGMENT_SPAN;
+	unsigned long i;
+
+	memset(sieve->segment, 0xff, PRIME_SEGMENT_BYTES);
+	if (low == 0) {
+		sieve->segment[0] &= (unsigned char)~1;  /* 1 is not a prime */
+	}
+
+	for (i = 0; i < sieve->base_count; i++) {
+		const unsigned long p = sieve->base_primes[i];
+		const unsigned long inverse = wheel_inverses[p % 30];
+		unsigned long start;
+		unsigned int bit;
+
+		if (p * p >= high) {
+			break;
+		}
+
+		start = (low + p - 1) / p;
+		if (start < p) {
+			start = p;
+		}
+
+		for (bit = 0; bit < 8; bit++) {
+			const unsigned long wanted = (wheel_residues[bit] * inverse) % 30;
+			const unsigned long k = start + (wanted + 30 - start % 30) % 30;
+			const unsigned char mask = (unsigned char)~(1U << bit);
+			unsigned long multiple;
+
+			for (multiple = p * k; multiple < high; multiple += 30 * p) {
+				sieve->segment[(multiple - low) / 30] &= mask;
+			}
+		}
+	}
+
+	sieve->low = low;
+	sieve->valid = 1;
+}
+
+/** Tell whether a value is a prime
+ *
+ * Values other than whole numbers are no primes.
+ *
+ * @param[in,out] sieve
+ * @param[in] value
+ * @param[out] prime
+ *
+ * @return status
+ *
+ * @since 1.2
+ */
+prime_status prime_sieve_check(prime_sieve * sieve, double value, int * prime) {
+	unsigned long number;
+	unsigned long low;
+	int bit;
+
+	if ((value < 2) || (floor(value) != value)) {
+		*prime = 0;
+		return PRIME_SUCCESS;
+	}
+	if (value > PRIME_MAX) {
+		return PRIME_TOO_LARGE;
+	}
+
+	number = (unsigned long)value;
+	bit = wheel_bits[number % 30];
+	if (number < 7) {
+		*prime = (number == 2) || (number == 3) || (number == 5);
+		return PRIME_SUCCESS;
+	}
+	if (bit < 0) {
+		*prime = 0;
+		return PRIME_SUCCESS;
+	}
+
+	low = number - number % PRIME_SEGMENT_SPAN;
+	if (! sieve->valid || (low != sieve->low)) {
+		if (! ensure_base_primes(sieve,
+				(unsigned long)sqrt((double)(low + PRIME_SEGMENT_SPAN)) + 1)) {
+			return PRIME_OUT_OF_MEMORY;
+		}
+		sieve_segment(sieve, low);
+	}
+
+	*prime = (sieve->segment[(number - low) / 30] >> bit) & 1;
+	return PRIME_SUCCESS;
+}
+
+/** Free memory held by a sieve
+ *
+ * @param[in,out] sieve
+ *
+ * @since 1.2
+ */
+void prime_sieve_free(prime_sieve * sieve) {
+	free(sieve->base_primes);
+	free(sieve->segment);
+	sieve->base_primes = NULL;
+	sieve->segment = NULL;
+}
@@ -0,0 +1,99 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PRIMES_H
+#define PRIMES_H 1
+
+#include <limits.h>  /* for ULONG_MAX */
+
+/** Number of bytes per segment, each byte covering 30 numbers
+ *
+ * A segment of 32 KiB fits into the L1 data cache of most CPUs.
+ *
+ * @since 1.2
+ */
+#define PRIME_SEGMENT_BYTES  32768
+
+/** Number of numbers covered by a segment
+ *
+ * @since 1.2
+ */
+#define PRIME_SEGMENT_SPAN  (30UL * PRIME_SEGMENT_BYTES)
+
+/** Largest value to check, 2^53 or less if unsigned long is narrower
+ *
+ * @since 1.2
+ */
+#define PRIME_MAX  ((ULONG_MAX / 4 < 9007199254740992.0) \
+	? (double)(ULONG_MAX / 4) \
+	: 9007199254740992.0)
+
+/** Enumeration of possible return values of prime_sieve_check()
+ *
+ * @since 1.2
+ */
+typedef enum _prime_status {
+	PRIME_SUCCESS,
+	PRIME_TOO_LARGE,       /**< value beyond PRIME_MAX */
+	PRIME_OUT_OF_MEMORY
+} prime_status;
+
+/** State of a segmented sieve of Eratosthenes
+ *
+ * Numbers are sieved one segment at a time, the segment holding the
+ * number asked about last.  With a wheel of 2 * 3 * 5 = 30, each byte
+ * covers 30 numbers with one bit per residue coprime to 30, i.e.
+ * 1, 7, 11, 13, 17, 19, 23 and 29.
+ *
+ * @since 1.2
+ */
+typedef struct _prime_sieve {
+	unsigned long * base_primes;  /**< primes from 7 to base_limit, ascending */
+	unsigned long base_count;     /**< number of entries in base_primes */
+	unsigned long base_limit;     /**< bound of base primes sieved so far */
+	unsigned char * segment;      /**< bits of numbers in current segment */
+	unsigned long low;            /**< first number of current segment */
+	int valid;                    /**< non-zero once a segment was sieved */
+} prime_sieve;
+
+int prime_sieve_init(prime_sieve * sieve);
+prime_status prime_sieve_check(prime_sieve * sieve, double value, int * prime);
+void prime_sieve_free(prime_sieve * sieve);
+
+#endif /* PRIMES_H */
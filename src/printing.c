@@ -42,8 +42,41 @@
 #include "utils.h"
 
 #include <stdlib.h>  /* for malloc */
-#include <stdio.h>  /* for FILE*, fopen, fclose */
-#include <string.h>  /* for strncpy */
+#include <stdio.h>  /* for printf, sprintf, fwrite */
+#include <string.h>  /* for memcpy, strncmp */
+#include <math.h>  /* for fabs, floor */
+#include <limits.h>  /* for ULONG_MAX */
+#include <ctype.h>  /* for isdigit */
+
+/** Size of the buffer collecting output for an output sink
+ *
+ * @since 1.2
+ */
+#define OUTPUT_BUFFER_SIZE  (64 * 1024)
+
+/** Size of the buffer on the stack holding subformats not longer than that
+ *
+ * @since 1.2
+ */
+#define SHORT_SUBFORMAT_SIZE  64
+
+/** Sink to pass output to instead of stdout (or NULL) */
+static output_sink current_sink = NULL;
+
+/** Output collected for current_sink */
+static char output_buffer[OUTPUT_BUFFER_SIZE];
+
+/** Number of bytes used in output_buffer */
+static size_t output_buffer_used = 0;
+
+/** Whether current_sink asked for no more output */
+static int output_stopped = 0;
+
+/** Buffer to render text into instead of printing it (or NULL) */
+static text_buffer * current_capture = NULL;
+
+/** Buffer to render text into when only checking or measuring it */
+static text_buffer measure_buffer = {NULL, 0, 0};
 
 /** @name printf specifier groups
  *
@@ -105,68 +138,293 @@ typedef enum _format_parse_state {
 } format_parse_state;
 
 
+/** Install a function to receive output instead of stdout.
+ *
+ * Output is passed on in blocks of up to 64 KiB.  Output still buffered
+ * is flushed to the previous sink first.
+ *
+ * @param[in] sink Function to receive output, NULL for stdout
+ *
+ * @since 1.2
+ */
+void set_output_sink(output_sink sink) {
+	flush_output();
+	current_sink = sink;
+	output_stopped = 0;
+}
+
+/** Pass output buffered so far on to the output sink.
+ *
+ * @since 1.2
+ */
+void flush_output(void) {
+	if (current_sink && (output_buffer_used > 0) && ! output_stopped) {
+		output_stopped = ! current_sink(output_buffer, output_buffer_used);
+	}
+	output_buffer_used = 0;
+}
+
+/** Tells whether the output sink asked for no more output.
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+int is_output_stopped(void) {
+	return output_stopped;
+}
+
+/** Print bytes to stdout or the output sink.
+ *
+ * @param[in] data
+ * @param[in] length Number of bytes, NUL bytes included
+ *
+ * @since 1.2
+ */
+void output_bytes(const char * data, size_t length) {
+	if (! current_sink) {
+		fwrite(data, 1, length, stdout);
+		return;
+	}
+
+	while ((length > 0) && ! output_stopped) {
+		const size_t take = ENUM_MIN(length, OUTPUT_BUFFER_SIZE - output_buffer_used);
+
+		memcpy(output_buffer + output_buffer_used, data, take);
+		output_buffer_used += take;
+		data += take;
+		length -= take;
+
+		if (output_buffer_used == OUTPUT_BUFFER_SIZE) {
+			flush_output();
+		}
+	}
+}
+
+/** Makes room for a number of bytes more in a text buffer.
+ *
+ * @param[in,out] dest
+ * @param[in] length Number of bytes
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int reserve_text(text_buffer * dest, size_t length) {
+	if (dest->length + length > dest->capacity) {
+		const size_t capacity = ENUM_MAX(2 * dest->capacity, dest->length + length);
+		char * const grown = (char *)realloc(dest->data, capacity);
+		if (! grown) {
+			return 0;
+		}
+		dest->data = grown;
+		dest->capacity = capacity;
+	}
+	return 1;
+}
+
+/** Tells how many bytes sprintf may print at most for a subformat.
+ *
+ * Widths and precisions are added on top of the longest double
+ * printed with "%f", i.e. about 310 characters.
+ *
+ * @param[in] subformat Valid format with one point of interpolation at most
+ *
+ * @return Number of bytes including the terminating NUL byte
+ *
+ * @since 1.2
+ */
+static size_t sprintf_bound(const char * subformat) {
+	size_t bound = strlen(subformat) + 512;
+	const char * walker = subformat;
+
+	while (walker[0] != '\0') {
+		if (isdigit((unsigned char)walker[0])) {
+			char * after_number;
+			bound += strtoul(walker, &after_number, 10);
+			walker = after_number;
+		} else {
+			walker++;
+		}
+	}
+	return bound;
+}
+
+/** Prints an integral value the way "%.0f" does, followed by literal text.
+ *
+ * Integral values are what "%.0f", the default format for integral
+ * steps, prints most of the time, so sprintf is left out for them.
+ *
+ * @param[in] value Integral value, non-zero and of magnitude below ULONG_MAX
+ * @param[in] suffix Literal text following the point of interpolation
+ * @param[in] after_suffix
+ * @param[in] pretend
+ * @param[in,out] length Number of bytes to increase by bytes printed (or NULL)
+ *
+ * @return success status as represented by custom_printf_return
+ *
+ * @since 1.2
+ */
+static custom_printf_return print_integral(double value, const char * suffix,
+		const char * after_suffix, int pretend, size_t * length) {
+	char digits[sizeof(unsigned long) * 3 + 2];
+	char * walker = digits + sizeof(digits);
+	unsigned long magnitude = (unsigned long)fabs(value);
+	size_t digit_count;
+	const size_t suffix_length = after_suffix - suffix;
+
+	do {
+		*--walker = (char)('0' + magnitude % 10);
+		magnitude /= 10;
+	} while (magnitude > 0);
+	if (value < 0) {
+		*--walker = '-';
+	}
+	digit_count = digits + sizeof(digits) - walker;
+
+	if (pretend) {
+		/* Nothing to print */
+	} else if (current_capture) {
+		if (! reserve_text(current_capture, digit_count + suffix_length)) {
+			return CUSTOM_PRINTF_OUT_OF_MEMORY;
+		}
+		memcpy(current_capture->data + current_capture->length, walker, digit_count);
+		memcpy(current_capture->data + current_capture->length + digit_count,
+			suffix, suffix_length);
+		current_capture->length += digit_count + suffix_length;
+	} else if (current_sink) {
+		output_bytes(walker, digit_count);
+		output_bytes(suffix, suffix_length);
+	} else {
+		fwrite(walker, 1, digit_count, stdout);
+		fwrite(suffix, 1, suffix_length, stdout);
+	}
+
+	if (length) {
+		*length += digit_count + suffix_length;
+	}
+	return CUSTOM_PRINTF_SUCCESS;
+}
+
+
 /** Helper function called by multi_printf.
  *
  * Runs printf on the format from start to after_last (exclusively) passing a
  * casted instanced value as needed. With pretend != 0 no printing will be
  * done; instead, the given format will be checked for validity.
  *
- * Function prints to stdout.
+ * Function prints to stdout or the output sink.
  *
  * @param[in] start
  * @param[in] after_last
  * @param[in] specifier
  * @param[in] value
  * @param[in] pretend
+ * @param[in,out] length Number of bytes to increase by bytes printed (or NULL)
  *
  * @return success status as represented by custom_printf_return
  *
  * @since 0.3
  */
-static custom_printf_return single_cast_printf(const char *start, const char *after_last, char specifier, float value, int pretend) {
+static custom_printf_return single_cast_printf(const char *start, const char *after_last, char specifier, double value, int pretend, size_t * length) {
 	const int len = after_last - start;
-	char * const subformat = (char *)malloc(len + 1);
+	char short_subformat[SHORT_SUBFORMAT_SIZE];
+	char * subformat = short_subformat;
 	static const char * const safety_pointer = "Should never be printed";
 	int res;
-	FILE * file = stdout;
+	char * text = NULL;
+
+	if ((specifier == 'f') && (len >= 4) && ! strncmp(start, "%.0f", 4)
+			&& (value != 0) && (value == floor(value))
+			&& (fabs(value) < (double)ULONG_MAX)) {
+		return print_integral(value, start + 4, after_last, pretend, length);
+	}
 
+	if (len >= SHORT_SUBFORMAT_SIZE) {
+		subformat = (char *)malloc(len + 1);
+	}
 	if (!subformat) {
 		return CUSTOM_PRINTF_OUT_OF_MEMORY;
 	}
 
+	memcpy(subformat, start, len);
+	subformat[len] = '\0';
+
 	if (pretend) {
-		file = fopen("/dev/null", "w");
-		assert(file);
+		/* Rendered into a buffer kept for reuse and dropped */
+		measure_buffer.length = 0;
+		if (! reserve_text(&measure_buffer, sprintf_bound(subformat))) {
+			if (subformat != short_subformat) {
+				free(subformat);
+			}
+			return CUSTOM_PRINTF_OUT_OF_MEMORY;
+		}
+		text = measure_buffer.data;
+	} else if (current_capture) {
+		/* Captured text is printed in place */
+		if (! reserve_text(current_capture, sprintf_bound(subformat))) {
+			if (subformat != short_subformat) {
+				free(subformat);
+			}
+			return CUSTOM_PRINTF_OUT_OF_MEMORY;
+		}
+		text = current_capture->data + current_capture->length;
+	} else if (current_sink) {
+		text = (char *)malloc(sprintf_bound(subformat));
+		if (! text) {
+			if (subformat != short_subformat) {
+				free(subformat);
+			}
+			return CUSTOM_PRINTF_OUT_OF_MEMORY;
+		}
 	}
 
-	strncpy(subformat, start, len);
-	subformat[len] = '\0';
-
 	switch (specifier) {
 	case '\0':
 	case '%':
-		res = fprintf(file, subformat, safety_pointer, safety_pointer, safety_pointer);
+		res = text
+			? sprintf(text, subformat, safety_pointer, safety_pointer, safety_pointer)
+			: printf(subformat, safety_pointer, safety_pointer, safety_pointer);
 		break;
 	CASE_INT_LIKE_SPECIFIER
-		res = fprintf(file, subformat, (int)value, safety_pointer, safety_pointer);
+		res = text
+			? sprintf(text, subformat, (int)value, safety_pointer, safety_pointer)
+			: printf(subformat, (int)value, safety_pointer, safety_pointer);
 		break;
 	CASE_FLOAT_LIKE_SPECIFIER
-		res = fprintf(file, subformat, value, safety_pointer, safety_pointer);
+		res = text
+			? sprintf(text, subformat, value, safety_pointer, safety_pointer)
+			: printf(subformat, value, safety_pointer, safety_pointer);
 		break;
 	default:
 		assert(0);
 	}
 
 	if (pretend) {
-		fclose(file);
+		/* Nothing to pass on */
+	} else if (current_capture) {
+		if (res > 0) {
+			current_capture->length += res;
+		}
+	} else if (text) {
+		if (res > 0) {
+			output_bytes(text, res);
+		}
+		free(text);
 	}
 
-	free(subformat);
+	if (subformat != short_subformat) {
+		free(subformat);
+	}
 
 	if ((res < 0) || ((res == 0) && (len > 0))) {
 		return CUSTOM_PRINTF_INVALID_FORMAT_PRINTF;
 	}
 
+	if (length) {
+		*length += res;
+	}
+
 	return CUSTOM_PRINTF_SUCCESS;
 }
 
@@ -181,12 +439,13 @@ static custom_printf_return single_cast_printf(const char *start, const char *af
  * @param[in] format
  * @param[in] value
  * @param[in] pretend
+ * @param[in,out] length Number of bytes to increase by bytes printed (or NULL)
  *
  * @return success status as represented by custom_printf_return
  *
  * @since 0.3
  */
-static custom_printf_return multi_printf_internal(const char * format, float value, int pretend) {
+static custom_printf_return multi_printf_internal(const char * format, double value, int pretend, size_t * length) {
 	const char * start = format;
 	const char * walker = format;
 	char specifier = '\0';
@@ -204,7 +463,7 @@ static custom_printf_return multi_printf_internal(const char * format, float val
 		case STATE_AT_LAST:
 			if (walker[0] == '%') {
 				if ((walker > start) && (specifier != '%')) {
-					res = single_cast_printf(start, walker, specifier, value, pretend);
+					res = single_cast_printf(start, walker, specifier, value, pretend, length);
 					if (res != CUSTOM_PRINTF_SUCCESS) {
 						return res;
 					}
@@ -308,7 +567,7 @@ static custom_printf_return multi_printf_internal(const char * format, float val
 	}
 
 	if (walker > start) {
-		res = single_cast_printf(start, walker, specifier, value, pretend);
+		res = single_cast_printf(start, walker, specifier, value, pretend, length);
 	}
 
 	return res;
@@ -328,8 +587,80 @@ static custom_printf_return multi_printf_internal(const char * format, float val
  *
  * @since 0.3
  */
-custom_printf_return multi_printf(const char * format, float value) {
-	return multi_printf_internal(format, value, 0);
+custom_printf_return multi_printf(const char * format, double value) {
+	return multi_printf_internal(format, value, 0, NULL);
+}
+
+
+/** Render value using custom format string into a text buffer.
+ *
+ * Like multi_printf, but the text replaces the content of dest rather
+ * than being printed, so that it can be printed again and again.
+ *
+ * @param[in] format
+ * @param[in] value
+ * @param[in,out] dest Buffer to reuse, initially all zeroes
+ *
+ * @return success state as represented by custom_printf_return
+ *
+ * @since 1.2
+ */
+custom_printf_return multi_printf_text(const char * format, double value, text_buffer * dest) {
+	custom_printf_return res;
+
+	dest->length = 0;
+	current_capture = dest;
+	res = multi_printf_internal(format, value, 0, NULL);
+	current_capture = NULL;
+	return res;
+}
+
+
+/** Measure the number of bytes a value would take printed.
+ *
+ * Like multi_printf, but output is discarded and only counted.
+ *
+ * @param[in] format
+ * @param[in] value
+ * @param[out] length Number of bytes multi_printf would print
+ *
+ * @return success state as represented by custom_printf_return
+ *
+ * @since 1.2
+ */
+custom_printf_return multi_printf_length(const char * format, double value, size_t * length) {
+	*length = 0;
+	return multi_printf_internal(format, value, 1, length);
+}
+
+
+/** Checks whether the printed length of values grows with their magnitude.
+ *
+ * This holds for all specifiers but "%g" and "%G", which switch between
+ * fixed and exponential notation, as long as the sign does not change
+ * and magnitudes do not cross 1 (because of exponents like "e-05").
+ *
+ * @param[in] format Valid format
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+int is_length_monotone_format(const char * format) {
+	const char * walker = format;
+
+	while ((walker = strchr(walker, '%')) != NULL) {
+		walker += strspn(walker + 1, "#0 '+-123456789.") + 1;
+		switch (walker[0]) {
+		case 'g':
+		case 'G':
+			return 0;
+		case '\0':
+			return 1;
+		}
+		walker++;
+	}
+	return 1;
 }
 
 
@@ -344,5 +675,5 @@ custom_printf_return multi_printf(const char * format, float value) {
  * @since 0.3
  */
 custom_printf_return is_valid_format(const char * format) {
-	return multi_printf_internal(format, 1.23456f, 1);
+	return multi_printf_internal(format, 1.23456f, 1, NULL);
 }
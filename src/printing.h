@@ -40,6 +40,8 @@
 #ifndef PRINTING_H
 #define PRINTING_H 1
 
+#include <sys/types.h>  /* for size_t */
+
 /** Simple enumeration of possible return values of custom printf functions */
 typedef enum _custom_printf_return {
 	CUSTOM_PRINTF_SUCCESS,
@@ -48,7 +50,36 @@ typedef enum _custom_printf_return {
 	CUSTOM_PRINTF_OUT_OF_MEMORY
 } custom_printf_return;
 
+/** Growing buffer for text rendered by multi_printf_text
+ *
+ * @since 1.2
+ */
+typedef struct _text_buffer {
+	char * data;     /**< rendered text, not NUL-terminated */
+	size_t length;   /**< number of bytes used */
+	size_t capacity; /**< number of bytes allocated */
+} text_buffer;
+
+/** Function to receive output instead of stdout
+ *
+ * @param[in] data
+ * @param[in] length Number of bytes
+ *
+ * @return non-zero to receive more output, zero to stop
+ *
+ * @since 1.2
+ */
+typedef int (*output_sink)(const char * data, size_t length);
+
+void set_output_sink(output_sink sink);
+void flush_output(void);
+int is_output_stopped(void);
+void output_bytes(const char * data, size_t length);
+
 custom_printf_return is_valid_format(const char * format);
-custom_printf_return multi_printf(const char * format, float value);
+custom_printf_return multi_printf(const char * format, double value);
+custom_printf_return multi_printf_text(const char * format, double value, text_buffer * dest);
+custom_printf_return multi_printf_length(const char * format, double value, size_t * length);
+int is_length_monotone_format(const char * format);
 
 #endif /* PRINTING_H */
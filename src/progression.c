@@ -0,0 +1,424 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "progression.h"
+#include "assertion.h"
+
+#include <stdlib.h>  /* for malloc */
+#include <string.h>  /* for memcpy */
+#include <math.h>    /* for fmod, floor */
+
+/** Remainder of value divided by modulus, from 0 to modulus - 1
+ *
+ * @param[in] value Integer of magnitude up to 2^53
+ * @param[in] modulus Positive integer up to 2^53
+ *
+ * @return remainder
+ *
+ * @since 1.2
+ */
+static double modulo(double value, double modulus) {
+	const double remainder = fmod(value, modulus);
+	return (remainder < 0) ? remainder + modulus : remainder;
+}
+
+/** Sum of two remainders modulo modulus, without leaving 2^53
+ *
+ * @param[in] a Integer from 0 to modulus - 1
+ * @param[in] b Integer from 0 to modulus - 1
+ * @param[in] modulus Positive integer up to 2^53
+ *
+ * @return (a + b) mod modulus
+ *
+ * @since 1.2
+ */
+static double add_modulo(double a, double b, double modulus) {
+	return (a >= modulus - b) ? a - (modulus - b) : a + b;
+}
+
+/** Product of two remainders modulo modulus, without leaving 2^53
+ *
+ * Doubles and adds like binary long multiplication would.
+ *
+ * @param[in] a Integer from 0 to modulus - 1
+ * @param[in] b Integer from 0 to modulus - 1
+ * @param[in] modulus Positive integer up to 2^53
+ *
+ * @return (a * b) mod modulus
+ *
+ * @since 1.2
+ */
+static double multiply_modulo(double a, double b, double modulus) {
+	double result = 0;
+
+	while (b > 0) {
+		if (fmod(b, 2) == 1) {
+			result = add_modulo(result, a, modulus);
+		}
+		a = add_modulo(a, a, modulus);
+		b = floor(b / 2);
+	}
+	return result;
+}
+
+/** Inverse of value modulo modulus by the extended Euclidean algorithm
+ *
+ * @param[in] value Integer from 0 to modulus - 1, coprime to modulus
+ * @param[in] modulus Positive integer up to 2^53
+ *
+ * @return x from 0 to modulus - 1 with (value * x) mod modulus = 1
+ *
+ * @since 1.2
+ */
+static double inverse_modulo(double value, double modulus) {
+	double previous_remainder = value;
+	double remainder = modulus;
+	double previous_coefficient = 1;
+	double coefficient = 0;
+
+	while (remainder != 0) {
+		const double quotient = floor(previous_remainder / remainder);
+		const double next_remainder = previous_remainder - quotient * remainder;
+		const double next_coefficient = previous_coefficient - quotient * coefficient;
+
+		previous_remainder = remainder;
+		remainder = next_remainder;
+		previous_coefficient = coefficient;
+		coefficient = next_coefficient;
+	}
+
+	assert(previous_remainder == 1);
+	return modulo(previous_coefficient, modulus);
+}
+
+/** Greatest common divisor
+ *
+ * @param[in] a Positive integer up to 2^53
+ * @param[in] b Positive integer up to 2^53
+ *
+ * @return greatest common divisor
+ *
+ * @since 1.2
+ */
+static double greatest_common_divisor(double a, double b) {
+	while (b != 0) {
+		const double remainder = fmod(a, b);
+		a = b;
+		b = remainder;
+	}
+	return a;
+}
+
+/** Intersect two progressions
+ *
+ * Rather than filtering values, the first common value is solved for
+ * by the Chinese remainder theorem: common values are those congruent
+ * to both a->first modulo a->step and b->first modulo b->step, i.e.
+ * a single residue modulo the least common multiple of both steps.
+ *
+ * @param[in] a
+ * @param[in] b
+ * @param[out] dest Intersection, valid on PROGRESSION_SUCCESS only
+ *
+ * @return status
+ *
+ * @since 1.2
+ */
+progression_status progression_intersect(const progression * a,
+		const progression * b, progression * dest) {
+	const double divisor = greatest_common_divisor(a->step, b->step);
+	const double a_factor = a->step / divisor;
+	const double b_factor = b->step / divisor;
+	const double lowest = (a->first > b->first) ? a->first : b->first;
+	double difference;
+	double multiple;
+	double lcm;
+	double residue;
+	double offset;
+
+	assert(a->step > 0);
+	assert(b->step > 0);
+
+	/* Congruent at all? */
+	difference = add_modulo(modulo(b->first, b->step),
+		b->step - modulo(a->first, b->step), b->step);
+	if (fmod(difference, divisor) != 0) {
+		return PROGRESSION_EMPTY;
+	}
+
+	if (a_factor > PROGRESSION_MAX_EXACT / b->step) {
+		return PROGRESSION_TOO_LARGE;
+	}
+	lcm = a_factor * b->step;
+
+	/* a->first + multiple * a->step is congruent to b->first modulo b->step */
+	multiple = (b_factor == 1)
+		? 0
+		: multiply_modulo(difference / divisor,
+			inverse_modulo(modulo(a_factor, b_factor), b_factor), b_factor);
+	residue = add_modulo(modulo(a->first, lcm), multiple * a->step, lcm);
+
+	/* First common value not below either first value */
+	offset = residue - modulo(lowest, lcm);
+	if (offset < 0) {
+		offset += lcm;
+	}
+
+	dest->first = lowest + offset;
+	dest->step = lcm;
+	dest->infinite = a->infinite && b->infinite;
+	if (a->infinite) {
+		dest->last = b->last;
+	} else if (b->infinite) {
+		dest->last = a->last;
+	} else {
+		dest->last = (a->last < b->last) ? a->last : b->last;
+	}
+
+	if ((! dest->infinite && (dest->first > dest->last))
+			|| (dest->first > PROGRESSION_MAX_EXACT)) {
+		return PROGRESSION_EMPTY;
+	}
+	return PROGRESSION_SUCCESS;
+}
+
+/** Check whether a progression contains a value
+ *
+ * @param[in] p
+ * @param[in] value Integer
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+int progression_contains(const progression * p, double value) {
+	return (value >= p->first)
+		&& (p->infinite || (value <= p->last))
+		&& (fmod(value - p->first, p->step) == 0);
+}
+
+/** Check whether an included progression has no more values
+ *
+ * @param[in] merge
+ * @param[in] index Index of included progression
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int is_exhausted(const progression_merge * merge, unsigned int index) {
+	const progression * const p = merge->included + index;
+	const double value = merge->values[index];
+
+	return (value > PROGRESSION_MAX_EXACT) || (! p->infinite && (value > p->last));
+}
+
+/** Move a heap entry down until the heap is ordered again
+ *
+ * @param[in,out] merge
+ * @param[in] position Position in heap
+ *
+ * @since 1.2
+ */
+static void sift_down(progression_merge * merge, unsigned int position) {
+	for (;;) {
+		const unsigned int left = 2 * position + 1;
+		const unsigned int right = left + 1;
+		unsigned int smallest = position;
+		unsigned int swap;
+
+		if ((left < merge->heap_size)
+				&& (merge->values[merge->heap[left]] < merge->values[merge->heap[smallest]])) {
+			smallest = left;
+		}
+		if ((right < merge->heap_size)
+				&& (merge->values[merge->heap[right]] < merge->values[merge->heap[smallest]])) {
+			smallest = right;
+		}
+		if (smallest == position) {
+			return;
+		}
+
+		swap = merge->heap[position];
+		merge->heap[position] = merge->heap[smallest];
+		merge->heap[smallest] = swap;
+		position = smallest;
+	}
+}
+
+/** Prepare a sorted merge of progressions
+ *
+ * With SET_UNION, values of any included progression are merged.  With
+ * SET_INTERSECTION, included progressions are intersected into a single
+ * one first.  Either way, values of excluded progressions are left out.
+ *
+ * @param[out] merge
+ * @param[in] operation SET_UNION or SET_INTERSECTION
+ * @param[in] included
+ * @param[in] included_count At least 1
+ * @param[in] excluded
+ * @param[in] excluded_count
+ *
+ * @return status, PROGRESSION_EMPTY is not used
+ *
+ * @since 1.2
+ */
+progression_status progression_merge_init(progression_merge * merge,
+		set_operation operation,
+		const progression * included, unsigned int included_count,
+		const progression * excluded, unsigned int excluded_count) {
+	int empty = 0;
+	unsigned int i;
+
+	assert(included_count > 0);
+	assert((operation == SET_UNION) || (operation == SET_INTERSECTION));
+
+	merge->included_count = (operation == SET_UNION) ? included_count : 1;
+	merge->excluded_count = excluded_count;
+	merge->included = (progression *)malloc(merge->included_count * sizeof(progression));
+	merge->excluded = (progression *)malloc((excluded_count + 1) * sizeof(progression));
+	merge->values = (double *)malloc(merge->included_count * sizeof(double));
+	merge->heap = (unsigned int *)malloc(merge->included_count * sizeof(unsigned int));
+	merge->heap_size = 0;
+	merge->previous = 0;
+	merge->started = 0;
+
+	if (! merge->included || ! merge->excluded || ! merge->values || ! merge->heap) {
+		progression_merge_free(merge);
+		return PROGRESSION_OUT_OF_MEMORY;
+	}
+
+	memcpy(merge->excluded, excluded, excluded_count * sizeof(progression));
+
+	if (operation == SET_UNION) {
+		memcpy(merge->included, included, included_count * sizeof(progression));
+	} else {
+		merge->included[0] = included[0];
+		for (i = 1; (i < included_count) && ! empty; i++) {
+			const progression previous = merge->included[0];
+
+			switch (progression_intersect(&previous, included + i, merge->included)) {
+			case PROGRESSION_SUCCESS:
+				break;
+			case PROGRESSION_EMPTY:
+				empty = 1;
+				break;
+			default:
+				progression_merge_free(merge);
+				return PROGRESSION_TOO_LARGE;
+			}
+		}
+	}
+
+	for (i = 0; (i < merge->included_count) && ! empty; i++) {
+		merge->values[i] = merge->included[i].first;
+		if (! is_exhausted(merge, i)) {
+			merge->heap[merge->heap_size++] = i;
+		}
+	}
+
+	for (i = merge->heap_size / 2; i > 0; i--) {
+		sift_down(merge, i - 1);
+	}
+	return PROGRESSION_SUCCESS;
+}
+
+/** Fetch the next value of a sorted merge of progressions
+ *
+ * @param[in,out] merge
+ * @param[out] value
+ *
+ * @return non-zero if a value was fetched, zero if no values are left
+ *
+ * @since 1.2
+ */
+int progression_merge_next(progression_merge * merge, double * value) {
+	while (merge->heap_size > 0) {
+		const unsigned int top = merge->heap[0];
+		const double candidate = merge->values[top];
+		int exhausted;
+		int duplicate;
+		int excluded = 0;
+		unsigned int i;
+
+		/* Advance the progression, dropping it once exhausted or once
+		 * the next value would be beyond 2^53 and round */
+		if (candidate > PROGRESSION_MAX_EXACT - merge->included[top].step) {
+			exhausted = 1;
+		} else {
+			merge->values[top] += merge->included[top].step;
+			exhausted = is_exhausted(merge, top);
+		}
+		if (exhausted) {
+			merge->heap[0] = merge->heap[--merge->heap_size];
+		}
+		sift_down(merge, 0);
+
+		duplicate = merge->started && (candidate == merge->previous);
+		for (i = 0; (i < merge->excluded_count) && ! duplicate && ! excluded; i++) {
+			excluded = progression_contains(merge->excluded + i, candidate);
+		}
+		if (duplicate || excluded) {
+			continue;
+		}
+
+		merge->previous = candidate;
+		merge->started = 1;
+		*value = candidate;
+		return 1;
+	}
+	return 0;
+}
+
+/** Free memory held by a sorted merge of progressions
+ *
+ * @param[in,out] merge
+ *
+ * @since 1.2
+ */
+void progression_merge_free(progression_merge * merge) {
+	free(merge->included);
+	free(merge->excluded);
+	free(merge->values);
+	free(merge->heap);
+	merge->included = NULL;
+	merge->excluded = NULL;
+	merge->values = NULL;
+	merge->heap = NULL;
+}
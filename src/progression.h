@@ -0,0 +1,113 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef PROGRESSION_H
+#define PROGRESSION_H 1
+
+/** Largest magnitude of integers that doubles hold exactly, 2^53
+ *
+ * @since 1.2
+ */
+#define PROGRESSION_MAX_EXACT  9007199254740992.0
+
+/** Enumeration of set operations on several ranges
+ *
+ * @since 1.2
+ */
+typedef enum _set_operation {
+	SET_NONE,         /**< no set operation (default) */
+	SET_UNION,        /**< values of any range */
+	SET_INTERSECTION  /**< values of all ranges */
+} set_operation;
+
+/** Ascending arithmetic progression of integers
+ *
+ * @since 1.2
+ */
+typedef struct _progression {
+	double first;  /**< smallest value */
+	double step;   /**< positive distance between neighboring values */
+	double last;   /**< largest value, unless infinite */
+	int infinite;  /**< non-zero if there is no largest value */
+} progression;
+
+/** State of a sorted merge of several progressions
+ *
+ * Values of included progressions are merged through a binary heap of
+ * their next values, without duplicates.  Values of any excluded
+ * progression are left out.
+ *
+ * @since 1.2
+ */
+typedef struct _progression_merge {
+	progression * included;        /**< progressions to merge */
+	unsigned int included_count;   /**< number of included progressions */
+	progression * excluded;        /**< progressions to leave out */
+	unsigned int excluded_count;   /**< number of excluded progressions */
+	double * values;               /**< next value of each included progression */
+	unsigned int * heap;           /**< included progressions by next value */
+	unsigned int heap_size;        /**< number of progressions not exhausted */
+	double previous;               /**< value returned last */
+	int started;                   /**< non-zero once a value was returned */
+} progression_merge;
+
+/** Enumeration of possible return values of progression_intersect()
+ * and progression_merge_init()
+ *
+ * @since 1.2
+ */
+typedef enum _progression_status {
+	PROGRESSION_SUCCESS,
+	PROGRESSION_EMPTY,          /**< intersection has no values */
+	PROGRESSION_TOO_LARGE,      /**< step of intersection beyond 2^53 */
+	PROGRESSION_OUT_OF_MEMORY
+} progression_status;
+
+progression_status progression_intersect(const progression * a,
+		const progression * b, progression * dest);
+int progression_contains(const progression * p, double value);
+
+progression_status progression_merge_init(progression_merge * merge,
+		set_operation operation,
+		const progression * included, unsigned int included_count,
+		const progression * excluded, unsigned int excluded_count);
+int progression_merge_next(progression_merge * merge, double * value);
+void progression_merge_free(progression_merge * merge);
+
+#endif /* PROGRESSION_H */
@@ -0,0 +1,206 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "quasi.h"
+
+#include <limits.h>  /* for ULONG_MAX */
+
+/** Scale of coordinates, 2^32 */
+#define QUASI_SCALE  4294967296.0
+
+/** Mask of the lower 32 bits of an unsigned long */
+#define QUASI_MASK  0xffffffffUL
+
+/** Primitive polynomial and initial direction numbers of a Sobol dimension
+ *
+ * Taken from S. Joe and F. Y. Kuo, "Constructing Sobol sequences with
+ * better two-dimensional projections", new-joe-kuo-6.21201, for
+ * dimensions 2 and up; dimension 1 is the van der Corput sequence.
+ *
+ * @since 1.2
+ */
+typedef struct _sobol_parameters {
+	unsigned int degree;          /**< degree s of polynomial */
+	unsigned int coefficients;    /**< inner coefficients a of polynomial */
+	unsigned int initial[5];      /**< initial direction numbers m_1 .. m_s */
+} sobol_parameters;
+
+static const sobol_parameters sobol_table[QUASI_MAX_DIMENSIONS - 1] = {
+	{1,  0, {1}},
+	{2,  1, {1, 3}},
+	{3,  1, {1, 3, 1}},
+	{3,  2, {1, 1, 1}},
+	{4,  1, {1, 1, 3, 3}},
+	{4,  4, {1, 3, 5, 13}},
+	{5,  2, {1, 1, 5, 5, 17}},
+	{5,  4, {1, 1, 5, 5, 5}},
+	{5,  7, {1, 1, 7, 11, 19}}
+};
+
+/** Prime bases of Halton dimensions */
+static const unsigned int halton_bases[QUASI_MAX_DIMENSIONS] = {
+	2, 3, 5, 7, 11, 13, 17, 19, 23, 29
+};
+
+/** Compute direction numbers of a Sobol dimension
+ *
+ * @param[out] directions
+ * @param[in] dimension Counting from 0
+ *
+ * @since 1.2
+ */
+static void sobol_directions(unsigned long * directions, unsigned int dimension) {
+	unsigned int i;
+
+	if (dimension == 0) {
+		for (i = 0; i < QUASI_BITS; i++) {
+			directions[i] = 1UL << (QUASI_BITS - 1 - i);
+		}
+	} else {
+		const sobol_parameters * const parameters = sobol_table + dimension - 1;
+		const unsigned int degree = parameters->degree;
+
+		for (i = 0; (i < degree) && (i < QUASI_BITS); i++) {
+			directions[i] = (unsigned long)parameters->initial[i] << (QUASI_BITS - 1 - i);
+		}
+		for (i = degree; i < QUASI_BITS; i++) {
+			unsigned int k;
+
+			directions[i] = directions[i - degree] ^ (directions[i - degree] >> degree);
+			for (k = 1; k < degree; k++) {
+				if ((parameters->coefficients >> (degree - 1 - k)) & 1) {
+					directions[i] ^= directions[i - k];
+				}
+			}
+		}
+	}
+}
+
+/** Prepare a dimension of a low-discrepancy sequence
+ *
+ * @param[out] sequence
+ * @param[in] type
+ * @param[in] dimension Counting from 0
+ *
+ * @return zero if dimension is not supported, non-zero otherwise
+ *
+ * @since 1.2
+ */
+int quasi_init(quasi_sequence * sequence, quasi_type type, unsigned int dimension) {
+	sequence->type = type;
+	sequence->base = 2;
+	sequence->index = 0;
+	sequence->coordinate = 0;
+	sequence->started = 0;
+
+	switch (type) {
+	case QUASI_SOBOL:
+		if (dimension >= QUASI_MAX_DIMENSIONS) {
+			return 0;
+		}
+		sobol_directions(sequence->directions, dimension);
+		break;
+	case QUASI_HALTON:
+		if (dimension >= QUASI_MAX_DIMENSIONS) {
+			return 0;
+		}
+		sequence->base = halton_bases[dimension];
+		break;
+	case QUASI_VDC:
+		if (dimension > 0) {
+			return 0;
+		}
+		break;
+	default:
+		break;
+	}
+	return 1;
+}
+
+/** Compute a coordinate of the point at a given index
+ *
+ * @param[in,out] sequence
+ * @param[in] index
+ *
+ * @return coordinate from 0 (inclusive) to 1 (exclusive)
+ *
+ * @since 1.2
+ */
+double quasi_point(quasi_sequence * sequence, unsigned long index) {
+	if (sequence->type == QUASI_SOBOL) {
+		index &= QUASI_MASK;
+
+		if (sequence->started && (index == ((sequence->index + 1) & QUASI_MASK)) && (index != 0)) {
+			/* Gray code of index differs from previous in the lowest zero bit of previous */
+			unsigned long previous = sequence->index;
+			unsigned int bit = 0;
+
+			while (previous & 1) {
+				previous >>= 1;
+				bit++;
+			}
+			sequence->coordinate ^= sequence->directions[bit];
+		} else {
+			const unsigned long gray = index ^ (index >> 1);
+			unsigned int bit;
+
+			sequence->coordinate = 0;
+			for (bit = 0; bit < QUASI_BITS; bit++) {
+				if ((gray >> bit) & 1) {
+					sequence->coordinate ^= sequence->directions[bit];
+				}
+			}
+		}
+
+		sequence->index = index;
+		sequence->started = 1;
+		return (double)sequence->coordinate / QUASI_SCALE;
+	} else {
+		/* Radical inverse: digits of index mirrored at the radix point */
+		const double base = sequence->base;
+		double scale = 1.0 / base;
+		double result = 0;
+
+		for (; index > 0; index /= sequence->base) {
+			result += (double)(index % sequence->base) * scale;
+			scale /= base;
+		}
+		return result;
+	}
+}
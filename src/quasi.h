@@ -0,0 +1,87 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef QUASI_H
+#define QUASI_H 1
+
+/** Number of bits of each coordinate, points repeat after 2^32
+ *
+ * @since 1.2
+ */
+#define QUASI_BITS  32
+
+/** Largest number of dimensions, i.e. ranges, supported
+ *
+ * @since 1.2
+ */
+#define QUASI_MAX_DIMENSIONS  10
+
+/** Enumeration of low-discrepancy sequences
+ *
+ * @since 1.2
+ */
+typedef enum _quasi_type {
+	QUASI_NONE,    /**< no low-discrepancy sequence (default) */
+	QUASI_SOBOL,   /**< Sobol sequence with Joe-Kuo direction numbers */
+	QUASI_HALTON,  /**< Halton sequence, one prime base per dimension */
+	QUASI_VDC      /**< van der Corput sequence in base 2 */
+} quasi_type;
+
+/** State of a single dimension of a low-discrepancy sequence
+ *
+ * For Sobol, the coordinate of the previous index is kept so that the
+ * next index only takes a single XOR with a direction number, following
+ * the Gray code of the index.  Any other index is computed from scratch,
+ * so the sequence can be entered at any point.
+ *
+ * @since 1.2
+ */
+typedef struct _quasi_sequence {
+	quasi_type type;                       /**< kind of sequence */
+	unsigned int base;                     /**< prime base (Halton and van der Corput) */
+	unsigned long directions[QUASI_BITS];  /**< direction numbers (Sobol) */
+	unsigned long index;                   /**< index of previous point */
+	unsigned long coordinate;              /**< coordinate of previous point, scaled by 2^32 (Sobol) */
+	int started;                           /**< non-zero once a point was computed */
+} quasi_sequence;
+
+int quasi_init(quasi_sequence * sequence, quasi_type type, unsigned int dimension);
+double quasi_point(quasi_sequence * sequence, unsigned long index);
+
+#endif /* QUASI_H */
@@ -0,0 +1,563 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "random.h"
+#include "chacha20.h"
+#include "assertion.h"
+
+#include <stdlib.h>  /* for rand, srand */
+#include <stdio.h>  /* for fopen, fread, fclose */
+#include <string.h>  /* for memset */
+#include <math.h>  /* for exp, fabs, floor, fmod, log, sqrt */
+#include <errno.h>  /* for errno, EINTR */
+#if defined(HAVE_GETRANDOM) && defined(HAVE_SYS_RANDOM_H)
+# include <sys/random.h>  /* for getrandom */
+#endif
+
+/** Number of ChaCha20 blocks to produce at a time in secure mode
+ *
+ * @since 1.2
+ */
+#define SECURE_BUFFER_BLOCKS  16
+
+/** @name State of the secure random number generator
+ *
+ * @since 1.2
+ */
+/*@{*/
+static int secure = 0;
+static chacha20_context chacha;
+static unsigned int keystream[SECURE_BUFFER_BLOCKS * CHACHA20_BLOCK_WORDS];
+static unsigned int keystream_left = 0;
+/*@}*/
+
+/** @name Ziggurat tables
+ *
+ * Layer boundaries for the ziggurat method of Marsaglia and Tsang
+ * (2000) with 128 layers for the normal and 256 layers for the
+ * exponential distribution.  Filled on first use by setup_ziggurat().
+ *
+ * @since 1.2
+ */
+/*@{*/
+static unsigned long kn[128];
+static double wn[128];
+static double fn[128];
+static unsigned long ke[256];
+static double we[256];
+static double fe[256];
+static int ziggurat_ready = 0;
+/*@}*/
+
+/** Cached state of the Zipf sampler.
+ *
+ * Values depending on exponent and number of elements only are computed
+ * once and re-used as long as these two parameters do not change.
+ *
+ * @since 1.2
+ */
+static struct {
+	double exponent;
+	double elements;
+	double h_integral_x1;
+	double h_integral_elements;
+	double s;
+} zipf = { 0.0, 0.0, 0.0, 0.0, 0.0 };
+
+/** Seed the random number generator.
+ *
+ * @param[in] seed
+ *
+ * @since 1.2
+ */
+void enum_random_seed(unsigned int seed) {
+	srand(seed);
+}
+
+/** Fill buffer with entropy from the operating system.
+ *
+ * Uses getrandom(2) where available, /dev/urandom otherwise.
+ *
+ * @param[out] dest
+ * @param[in] size Number of bytes wanted
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int fetch_entropy(unsigned char * dest, size_t size) {
+	FILE * file;
+	size_t bytes_read;
+
+#if defined(HAVE_GETRANDOM) && defined(HAVE_SYS_RANDOM_H)
+	while (size > 0) {
+		const ssize_t res = getrandom(dest, size, 0);
+		if (res < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			/* Try /dev/urandom, e.g. for kernels before 3.17 */
+			break;
+		}
+		dest += res;
+		size -= res;
+	}
+	if (size == 0) {
+		return 1;
+	}
+#endif
+
+	file = fopen("/dev/urandom", "rb");
+	if (! file) {
+		return 0;
+	}
+	bytes_read = fread(dest, 1, size, file);
+	fclose(file);
+	return bytes_read == size;
+}
+
+/** Switch to cryptographically secure random numbers.
+ *
+ * A ChaCha20 keystream is keyed once from the operating system's entropy
+ * source; random numbers are then taken from the keystream which is
+ * produced SECURE_BUFFER_BLOCKS blocks at a time.  Seeds passed to
+ * enum_random_seed() have no effect afterwards.
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+int enum_random_secure(void) {
+	unsigned char seed[4 * (CHACHA20_KEY_WORDS + CHACHA20_NONCE_WORDS)];
+
+	if (! fetch_entropy(seed, sizeof(seed))) {
+		return 0;
+	}
+
+	chacha20_init(&chacha, seed, seed + 4 * CHACHA20_KEY_WORDS, 0);
+	memset(seed, 0, sizeof(seed));
+
+	keystream_left = 0;
+	secure = 1;
+	return 1;
+}
+
+/** Produce 32 random bits.
+ *
+ * In secure mode bits are taken from the ChaCha20 keystream.  Otherwise,
+ * as RAND_MAX can be as low as 32767, several calls to rand() are
+ * combined as needed.
+ *
+ * @return Random number from 0 to 2^32-1
+ *
+ * @since 1.2
+ */
+unsigned long enum_random_bits(void) {
+	if (secure) {
+		if (keystream_left == 0) {
+			chacha20_keystream(&chacha, keystream, SECURE_BUFFER_BLOCKS);
+			keystream_left = sizeof(keystream) / sizeof(keystream[0]);
+		}
+		keystream_left--;
+		return keystream[keystream_left];
+	}
+
+#if RAND_MAX >= 0xffff
+	return (((unsigned long)rand() & 0xffffUL) << 16)
+		| ((unsigned long)rand() & 0xffffUL);
+#else
+	return ((((unsigned long)rand() & 0x7fffUL) << 30)
+		| (((unsigned long)rand() & 0x7fffUL) << 15)
+		| ((unsigned long)rand() & 0x7fffUL)) & 0xffffffffUL;
+#endif
+}
+
+/** Produce a uniformly distributed random number from the open interval (0, 1).
+ *
+ * Zero is never returned so that the result can be passed to log() safely.
+ *
+ * @return Random number greater than 0 and less than 1
+ *
+ * @since 1.2
+ */
+double enum_random_uniform(void) {
+	return (enum_random_bits() + 0.5) / 4294967296.0;
+}
+
+/** Produce a uniformly distributed random integer from 0 to count - 1.
+ *
+ * Random numbers from the top end that would favor some results over
+ * others (the so-called modulo bias) are rejected and drawn again.
+ *
+ * @param[in] count Number of possible results (1 to 2^53)
+ *
+ * @return Random integer from 0 to count - 1
+ *
+ * @since 1.2
+ */
+double enum_random_index(double count) {
+	assert((count >= 1) && (count <= 9007199254740992.0));
+
+	if (count <= 4294967295.0) {
+		const unsigned long n = (unsigned long)count;
+		/* Equals 2^32 mod n, computed without 33 bit arithmetic */
+		const unsigned long threshold = (0xffffffffUL - n + 1) % n;
+		unsigned long bits;
+
+		do {
+			bits = enum_random_bits();
+		} while (bits < threshold);
+		return (double)(bits % n);
+	} else {
+		/* 53 random bits are held by a double without loss */
+		const double range = 9007199254740992.0;
+		const double limit = range - fmod(range, count);
+		double bits;
+
+		do {
+			bits = (enum_random_bits() & 0x1fffffUL) * 4294967296.0
+				+ enum_random_bits();
+		} while (bits >= limit);
+		return fmod(bits, count);
+	}
+}
+
+/** Fill a buffer with characters drawn uniformly from an alphabet.
+ *
+ * Each 32 random bits yield several characters.  With 2^k characters,
+ * k bits are masked off per character and nothing is ever rejected.
+ * Otherwise, the bits are taken as digits in base size, and only
+ * numbers from the top end that would favor some characters over
+ * others are rejected, like in enum_random_index().
+ *
+ * @param[out] dest
+ * @param[in] length Number of characters wanted
+ * @param[in] alphabet Characters to draw from
+ * @param[in] size Number of characters in alphabet (2 to 256)
+ *
+ * @since 1.2
+ */
+void enum_random_text(char * dest, size_t length, const char * alphabet, size_t size) {
+	assert((size >= 2) && (size <= 256));
+
+	if ((size & (size - 1)) == 0) {
+		const unsigned long mask = size - 1;
+		unsigned int bits = 0;
+		unsigned int per_word;
+
+		while ((1UL << bits) < size) {
+			bits++;
+		}
+		per_word = 32 / bits;
+
+		while (length > 0) {
+			unsigned long word = enum_random_bits();
+			unsigned int i;
+
+			for (i = 0; (i < per_word) && (length > 0); i++, length--) {
+				*dest++ = alphabet[word & mask];
+				word >>= bits;
+			}
+		}
+	} else {
+		unsigned long span = size;
+		unsigned int per_word = 1;
+		unsigned long threshold;
+
+		/* Largest power of size that fits into 32 bits */
+		while (span <= 0xffffffffUL / size) {
+			span *= size;
+			per_word++;
+		}
+		/* Equals 2^32 mod span, computed without 33 bit arithmetic */
+		threshold = (0xffffffffUL - span + 1) % span;
+
+		while (length > 0) {
+			unsigned long word;
+			unsigned int i;
+
+			do {
+				word = enum_random_bits();
+			} while (word < threshold);
+			word %= span;
+
+			for (i = 0; (i < per_word) && (length > 0); i++, length--) {
+				*dest++ = alphabet[word % size];
+				word /= size;
+			}
+		}
+	}
+}
+
+/** Fill ziggurat tables.
+ *
+ * @since 1.2
+ */
+static void setup_ziggurat(void) {
+	const double m1 = 2147483648.0;
+	const double m2 = 4294967296.0;
+	const double vn = 9.91256303526217e-3;
+	const double ve = 3.949659822581572e-3;
+	double dn = 3.442619855899;
+	double tn = dn;
+	double de = 7.697117470131487;
+	double te = de;
+	double q;
+	int i;
+
+	/* Normal distribution */
+	q = vn / exp(-0.5 * dn * dn);
+	kn[0] = (unsigned long)((dn / q) * m1);
+	kn[1] = 0;
+	wn[0] = q / m1;
+	wn[127] = dn / m1;
+	fn[0] = 1.0;
+	fn[127] = exp(-0.5 * dn * dn);
+	for (i = 126; i >= 1; i--) {
+		dn = sqrt(-2.0 * log(vn / dn + exp(-0.5 * dn * dn)));
+		kn[i + 1] = (unsigned long)((dn / tn) * m1);
+		tn = dn;
+		fn[i] = exp(-0.5 * dn * dn);
+		wn[i] = dn / m1;
+	}
+
+	/* Exponential distribution */
+	q = ve / exp(-de);
+	ke[0] = (unsigned long)((de / q) * m2);
+	ke[1] = 0;
+	we[0] = q / m2;
+	we[255] = de / m2;
+	fe[0] = 1.0;
+	fe[255] = exp(-de);
+	for (i = 254; i >= 1; i--) {
+		de = -log(ve / de + exp(-de));
+		ke[i + 1] = (unsigned long)((de / te) * m2);
+		te = de;
+		fe[i] = exp(-de);
+		we[i] = de / m2;
+	}
+
+	ziggurat_ready = 1;
+}
+
+/** Produce a normally distributed random number.
+ *
+ * Uses the ziggurat method: in about 99% of all cases a single table
+ * lookup and multiplication is all it takes.
+ *
+ * @return Random number with mean 0 and standard deviation 1
+ *
+ * @since 1.2
+ */
+double enum_random_normal(void) {
+	const double r = 3.442620;
+
+	if (! ziggurat_ready) {
+		setup_ziggurat();
+	}
+
+	for (;;) {
+		const unsigned long bits = enum_random_bits();
+		const unsigned int iz = (unsigned int)(bits & 127);
+		const int negative = (bits & 0x80000000UL) != 0;
+		/* Interpret bits as two's complement 32 bit integer */
+		const unsigned long magnitude = negative
+			? ((~bits & 0xffffffffUL) + 1)
+			: bits;
+		const double hz = negative ? -(double)magnitude : (double)magnitude;
+		double x;
+
+		if (magnitude < kn[iz]) {
+			return hz * wn[iz];
+		}
+
+		if (iz == 0) {
+			/* Sample from the tail beyond r */
+			double y;
+			do {
+				x = -log(enum_random_uniform()) / r;
+				y = -log(enum_random_uniform());
+			} while (y + y < x * x);
+			return negative ? -r - x : r + x;
+		}
+
+		x = hz * wn[iz];
+		if (fn[iz] + enum_random_uniform() * (fn[iz - 1] - fn[iz])
+				< exp(-0.5 * x * x)) {
+			return x;
+		}
+	}
+}
+
+/** Produce an exponentially distributed random number.
+ *
+ * Uses the ziggurat method, see enum_random_normal().
+ *
+ * @return Random number with rate (and mean) 1
+ *
+ * @since 1.2
+ */
+double enum_random_exponential(void) {
+	if (! ziggurat_ready) {
+		setup_ziggurat();
+	}
+
+	for (;;) {
+		const unsigned long bits = enum_random_bits();
+		const unsigned int iz = (unsigned int)(bits & 255);
+		double x;
+
+		if (bits < ke[iz]) {
+			return bits * we[iz];
+		}
+
+		if (iz == 0) {
+			/* Sample from the tail beyond 7.69711 */
+			return 7.69711 - log(enum_random_uniform());
+		}
+
+		x = bits * we[iz];
+		if (fe[iz] + enum_random_uniform() * (fe[iz - 1] - fe[iz]) < exp(-x)) {
+			return x;
+		}
+	}
+}
+
+/** Calculate log(1 + x) / x, also for x close to zero.
+ *
+ * @param[in] x
+ *
+ * @return log(1 + x) / x
+ *
+ * @since 1.2
+ */
+static double zipf_helper1(double x) {
+	if (fabs(x) > 1e-4) {
+		return log(1.0 + x) / x;
+	}
+	return 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+}
+
+/** Calculate (exp(x) - 1) / x, also for x close to zero.
+ *
+ * @param[in] x
+ *
+ * @return (exp(x) - 1) / x
+ *
+ * @since 1.2
+ */
+static double zipf_helper2(double x) {
+	if (fabs(x) > 1e-4) {
+		return (exp(x) - 1.0) / x;
+	}
+	return 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x));
+}
+
+/** Zipf hat function h(x) = 1 / x^exponent
+ *
+ * @since 1.2
+ */
+static double zipf_h(double x) {
+	return exp(-zipf.exponent * log(x));
+}
+
+/** Integral of the Zipf hat function
+ *
+ * @since 1.2
+ */
+static double zipf_h_integral(double x) {
+	const double log_x = log(x);
+	return zipf_helper2((1.0 - zipf.exponent) * log_x) * log_x;
+}
+
+/** Inverse of zipf_h_integral()
+ *
+ * @since 1.2
+ */
+static double zipf_h_integral_inverse(double x) {
+	double t = x * (1.0 - zipf.exponent);
+	if (t < -1.0) {
+		/* Limit value to the range [-1, +inf) */
+		t = -1.0;
+	}
+	return exp(zipf_helper1(t) * x);
+}
+
+/** Produce a Zipf distributed random rank.
+ *
+ * Uses rejection-inversion sampling by Hoermann and Derflinger (1996):
+ * no tables are needed and the expected number of iterations is
+ * close to 1 for any number of elements.
+ *
+ * @param[in] exponent Exponent characterizing the distribution (> 0)
+ * @param[in] elements Number of ranks available (>= 1)
+ *
+ * @return Random rank from 1 to elements, rank 1 being most likely
+ *
+ * @since 1.2
+ */
+double enum_random_zipf(double exponent, double elements) {
+	assert(exponent > 0);
+	assert(elements >= 1);
+
+	if ((zipf.exponent != exponent) || (zipf.elements != elements)) {
+		zipf.exponent = exponent;
+		zipf.elements = elements;
+		zipf.h_integral_x1 = zipf_h_integral(1.5) - 1.0;
+		zipf.h_integral_elements = zipf_h_integral(elements + 0.5);
+		zipf.s = 2.0 - zipf_h_integral_inverse(zipf_h_integral(2.5) - zipf_h(2.0));
+	}
+
+	for (;;) {
+		const double u = zipf.h_integral_elements + enum_random_uniform()
+			* (zipf.h_integral_x1 - zipf.h_integral_elements);
+		const double x = zipf_h_integral_inverse(u);
+		double k = floor(x + 0.5);
+
+		if (k < 1.0) {
+			k = 1.0;
+		} else if (k > elements) {
+			k = elements;
+		}
+
+		if ((k - x <= zipf.s) || (u >= zipf_h_integral(k + 0.5) - zipf_h(k))) {
+			return k;
+		}
+	}
+}
@@ -0,0 +1,581 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ranges.h"
+#include "assertion.h"
+#include "utils.h"
+
+#include <stdlib.h>  /* for malloc */
+#include <math.h>  /* for fabs, floor */
+#include <limits.h>  /* for ULONG_MAX */
+#include <string.h>  /* for strchr, strlen */
+
+/** Makes a default format shared by several ranges printed as one
+ *
+ * The format uses the largest precision of all ranges and, with
+ * -e|--equal-width, the width of the widest bound of all ranges.
+ *
+ * @param[in,out] dest Scaffolding to work with
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int make_shared_format(scaffolding * dest) {
+	scaffolding bounds;
+	unsigned int precision = 0;
+	unsigned int i;
+
+	initialize_scaffold(&bounds);
+	bounds.flags = FLAG_LEFT_SET | FLAG_RIGHT_SET | (dest->flags & FLAG_EQUAL_WIDTH);
+
+	for (i = 0; i < dest->dimension_count; i++) {
+		const scaffolding * const range = dest->dimensions + i;
+		const unsigned int range_precision = CHECK_FLAG(range->flags, FLAG_USER_PRECISION)
+			? range->user_precision
+			: range->auto_precision;
+		const double low = ENUM_MIN(range->left, range->right);
+		const double high = ENUM_MAX(range->left, range->right);
+
+		precision = ENUM_MAX(precision, range_precision);
+		if ((i == 0) || (low < bounds.left)) {
+			bounds.left = low;
+		}
+		if ((i == 0) || (high > bounds.right)) {
+			bounds.right = high;
+		}
+	}
+
+	if (! make_default_format_string(&bounds, precision)) {
+		return 0;
+	}
+
+	for (i = 0; i < dest->dimension_count; i++) {
+		dest->dimensions[i].format = enum_strdup(bounds.format);
+		if (! dest->dimensions[i].format) {
+			free(bounds.format);
+			return 0;
+		}
+	}
+	free(bounds.format);
+	return 1;
+}
+
+/** Splits arguments at commas, making each comma an argument of its own
+ *
+ * For instance, "1..100,500..600" becomes "1..100", "," and "500..600".
+ * Unless attached commas are wanted, arguments are copied as they are,
+ * so that "1,2" stays a single (invalid) argument.
+ *
+ * @param[in] reduced_argc
+ * @param[in] reduced_argv
+ * @param[in] attached Whether to split at commas attached to ranges
+ * @param[out] new_argc
+ * @param[out] new_argv
+ *
+ * @return zero in case of failure, non-zero otherwise
+ *
+ * @since 1.2
+ */
+int split_at_commas(int reduced_argc, char ** reduced_argv, int attached,
+		int * new_argc, char *** new_argv) {
+	size_t pieces = reduced_argc;
+	int i;
+
+	for (i = 0; (i < reduced_argc) && attached; i++) {
+		const char * walker;
+		for (walker = reduced_argv[i]; (walker = strchr(walker, ',')) != NULL; walker++) {
+			pieces += 2;
+		}
+	}
+
+	*new_argc = 0;
+	*new_argv = (char **)malloc((pieces + 1) * sizeof(char *));
+	if (! *new_argv) {
+		return 0;
+	}
+
+	for (i = 0; i < reduced_argc; i++) {
+		const char * piece = reduced_argv[i];
+
+		for (;;) {
+			const char * const comma = attached ? strchr(piece, ',') : NULL;
+			const size_t len = comma ? (size_t)(comma - piece) : strlen(piece);
+
+			if (len > 0) {
+				(*new_argv)[*new_argc] = enum_strndup(piece, len);
+				if (! (*new_argv)[*new_argc]) {
+					return 0;
+				}
+				(*new_argc)++;
+			}
+			if (! comma) {
+				break;
+			}
+
+			(*new_argv)[*new_argc] = enum_strdup(",");
+			if (! (*new_argv)[*new_argc]) {
+				return 0;
+			}
+			(*new_argc)++;
+			piece = comma + 1;
+		}
+	}
+
+	return 1;
+}
+
+/** Converts a completed range of integers to an ascending progression
+ *
+ * @param[in] range Completed range, not infinite and descending
+ * @param[out] dest
+ *
+ * @return zero if values are not integers of magnitude up to 2^53,
+ *         non-zero otherwise
+ *
+ * @since 1.2
+ */
+int make_progression(const scaffolding * range, progression * dest) {
+	unsigned long count;
+
+	dest->first = range->left;
+	dest->step = fabs(range->step);
+	dest->infinite = ! count_values(range, &count);
+
+	if (! dest->infinite) {
+		const double last = (count > 0) ? value_at_position(range, count - 1) : range->left;
+
+		if (count <= 1) {
+			dest->step = 1;
+		}
+		if (last < dest->first) {
+			dest->last = dest->first;
+			dest->first = last;
+		} else {
+			dest->last = last;
+		}
+		if ((floor(dest->last) != dest->last) || (fabs(dest->last) > PROGRESSION_MAX_EXACT)) {
+			return 0;
+		}
+		if (count == 0) {
+			/* Empty, first beyond last */
+			dest->last = dest->first - 1;
+		}
+	}
+
+	return (floor(dest->first) == dest->first) && (fabs(dest->first) <= PROGRESSION_MAX_EXACT)
+		&& (floor(dest->step) == dest->step) && (dest->step > 0)
+		&& (dest->step <= PROGRESSION_MAX_EXACT);
+}
+
+/** Completes several ranges and their formats
+ *
+ * Each range is formatted by its --field-format=FORMAT, by the format
+ * given to -f|--format or by a default format of its own precision.
+ * Concatenated ranges and ranges of a set operation share a single
+ * default format instead.
+ *
+ * @param[in,out] dest Scaffolding to work with
+ *
+ * @return status
+ *
+ * @since 1.2
+ */
+ranges_status complete_ranges(scaffolding * dest) {
+	const int zip = CHECK_FLAG(dest->flags, FLAG_ZIP);
+	const int concat = CHECK_FLAG(dest->flags, FLAG_CONCAT);
+	const int set = (dest->operation != SET_NONE);
+	unsigned int i;
+
+	if (CHECK_FLAG(dest->flags, FLAG_RANDOM) || (dest->skip > 0)
+			|| CHECK_FLAG(dest->flags, FLAG_REVERSE)
+			|| (dest->shard_count > 0) || (dest->chunk_count > 0)
+			|| (dest->query != QUERY_NONE) || (dest->aggregates != 0)
+			|| CHECK_FLAG(dest->flags, FLAG_PREDICT_SIZE)) {
+		return RANGES_SINGLE_RANGE_OPTION;
+	}
+
+	if (concat && (zip || (dest->order != ORDER_ROW)
+			|| dest->field_separator || (dest->field_format_count > 0))) {
+		return RANGES_CONCAT_OPTION;
+	}
+
+	if (set && (zip || concat || (dest->order != ORDER_ROW)
+			|| dest->field_separator || (dest->field_format_count > 0))) {
+		return RANGES_SET_OPTION;
+	}
+
+	if (CHECK_FLAG(dest->flags, FLAG_GEOMETRIC) || CHECK_FLAG(dest->flags, FLAG_PRIMES)
+			|| CHECK_FLAG(dest->flags, FLAG_NUMBER_LINES) || (dest->string_length > 0)
+			|| dest->choice_file || (dest->walk != WALK_NONE)) {
+		return RANGES_SEQUENCE_OPTION;
+	}
+
+	if (zip && (dest->order != ORDER_ROW)) {
+		return RANGES_ZIP_ORDER;
+	}
+
+	if (dest->field_format_count > dest->dimension_count) {
+		return RANGES_TOO_MANY_FORMATS;
+	}
+
+	for (i = 0; i < dest->dimension_count; i++) {
+		scaffolding * const range = dest->dimensions + i;
+		const char * const format = (i < dest->field_format_count)
+			? dest->field_formats[i]
+			: dest->format;
+
+		if (CHECK_FLAG(range->flags, FLAG_EXCEPT) && ! set) {
+			return RANGES_EXCEPT_WITHOUT_SET;
+		}
+
+		if (CHECK_FLAG(range->flags, FLAG_RANDOM) && set) {
+			return RANGES_SET_RANDOM;
+		}
+
+		if (CHECK_FLAG(range->flags, FLAG_RANDOM) && ! concat) {
+			if (! zip) {
+				return RANGES_RANDOM_WITHOUT_ZIP;
+			}
+
+			/* Without a count, draw as many values as other ranges need */
+			if (! HAS_COUNT(range)) {
+				SET_COUNT(*range, ULONG_MAX);
+			}
+		}
+
+		complete_scaffold(range);
+
+		/* Inner ranges restart, so they need to end */
+		if (! zip && ! concat && ! set && (i > 0) && ! HAS_COUNT(range)) {
+			return RANGES_INNER_INFINITY;
+		}
+
+		if (set) {
+			progression dummy;
+
+			if (! HAS_COUNT(range) && (range->step < 0)) {
+				return RANGES_SET_DESCENDING_INFINITY;
+			}
+			if (! make_progression(range, &dummy)) {
+				return RANGES_SET_NOT_INTEGERS;
+			}
+		}
+
+		/* Later ranges of a concatenation would never be reached */
+		if (concat && (i + 1 < dest->dimension_count) && ! HAS_COUNT(range)) {
+			return RANGES_CONCAT_INFINITY;
+		}
+
+		if ((dest->order != ORDER_ROW) && ! HAS_COUNT(range)) {
+			return RANGES_ORDER_INFINITY;
+		}
+
+		if (CHECK_FLAG(range->flags, FLAG_EQUAL_WIDTH) && ! HAS_RIGHT(range)) {
+			return RANGES_EQUAL_WIDTH_INFINITY;
+		}
+
+		if ((concat || set) && ! format) {
+			continue;
+		} else if (format) {
+			range->format = enum_strdup(format);
+		} else {
+			make_default_format_string(range, CHECK_FLAG(range->flags, FLAG_USER_PRECISION)
+				? range->user_precision
+				: range->auto_precision);
+		}
+		if (! range->format) {
+			return RANGES_OUT_OF_MEMORY;
+		}
+	}
+
+	if ((concat || set) && ! dest->format && ! make_shared_format(dest)) {
+		return RANGES_OUT_OF_MEMORY;
+	}
+
+	return RANGES_SUCCESS;
+}
+
+/** Start a walk through the Cartesian product of several ranges.
+ *
+ * Tuples follow the order given by --order, row-major by default,
+ * i.e. the last range advances fastest, like nested loops would.  Only
+ * the first range may be infinite.
+ *
+ * @param[out] product
+ * @param[in] dest Scaffolding with completed ranges
+ *
+ * @return status, RANGES_TOO_LARGE or RANGES_OUT_OF_MEMORY on errors
+ *
+ * @since 1.2
+ */
+ranges_status range_product_init(range_product * product, scaffolding * dest) {
+	const unsigned int dimension_count = dest->dimension_count;
+	unsigned long * const counts = (unsigned long *)malloc(dimension_count * sizeof(unsigned long));
+	tuple_walk_status status;
+	unsigned int i;
+
+	product->dimensions = dest->dimensions;
+	product->dimension_count = dimension_count;
+	product->walking = 0;
+	product->finite = 1;
+	product->limited = CHECK_FLAG(dest->flags, FLAG_LIMIT_SET);
+	product->left = dest->limit;
+	product->done = product->limited && (dest->limit == 0);
+
+	if (! counts) {
+		return RANGES_OUT_OF_MEMORY;
+	}
+
+	for (i = 0; i < dimension_count; i++) {
+		if (! count_values(dest->dimensions + i, counts + i)) {
+			/* Only the first range may be infinite */
+			product->finite = product->limited;
+			counts[i] = 0;
+		} else if (counts[i] == 0) {
+			product->done = 1;
+		}
+	}
+
+	if (product->done) {
+		free(counts);
+		return RANGES_SUCCESS;
+	}
+
+	status = tuple_walk_init(&(product->walk), dest->order, dimension_count, counts,
+		dest->tile_size);
+	free(counts);
+
+	switch (status) {
+	case TUPLE_WALK_SUCCESS:
+		product->walking = 1;
+		return RANGES_SUCCESS;
+	case TUPLE_WALK_TOO_LARGE:
+		return RANGES_TOO_LARGE;
+	default:
+		return RANGES_OUT_OF_MEMORY;
+	}
+}
+
+/** Tells a value of the current tuple of a product.
+ *
+ * @param[in] product Product with a current tuple
+ * @param[in] index Index of the range
+ *
+ * @return value
+ *
+ * @since 1.2
+ */
+double range_product_value(range_product const * product, unsigned int index) {
+	assert(! product->done && (index < product->dimension_count));
+	return value_at_position(product->dimensions + index,
+		product->walk.positions[index]);
+}
+
+/** Advance a product to the next tuple.
+ *
+ * @param[in,out] product
+ *
+ * @return 1 if there is a next tuple, 0 after the last tuple
+ *
+ * @since 1.2
+ */
+int range_product_next(range_product * product) {
+	if (product->done) {
+		return 0;
+	}
+	if (product->limited && (--product->left == 0)) {
+		product->done = 1;
+		return 0;
+	}
+	if (! tuple_walk_next(&(product->walk))) {
+		product->done = 1;
+		return 0;
+	}
+	return 1;
+}
+
+/** Free memory allocated for a product.
+ *
+ * @param[in,out] product
+ *
+ * @since 1.2
+ */
+void range_product_free(range_product * product) {
+	if (product->walking) {
+		tuple_walk_free(&(product->walk));
+		product->walking = 0;
+	}
+}
+
+/** Start a walk through several ranges side by side.
+ *
+ * A random range without a count has been given a count of ULONG_MAX
+ * by complete_ranges(), so it draws as many values as other ranges need.
+ *
+ * @param[out] zip
+ * @param[in] dest Scaffolding with completed ranges
+ *
+ * @since 1.2
+ */
+void range_zip_init(range_zip * zip, scaffolding * dest) {
+	unsigned int i;
+
+	zip->dimensions = dest->dimensions;
+	zip->dimension_count = dest->dimension_count;
+	zip->limited = CHECK_FLAG(dest->flags, FLAG_LIMIT_SET);
+	zip->left = dest->limit;
+	zip->finite = zip->limited;
+	zip->random = 0;
+	zip->done = zip->limited && (dest->limit == 0);
+
+	for (i = 0; i < dest->dimension_count; i++) {
+		unsigned long count;
+
+		if (count_values(dest->dimensions + i, &count)) {
+			zip->finite = 1;
+			if (count == 0) {
+				zip->done = 1;
+			}
+		}
+		if (CHECK_FLAG(dest->dimensions[i].flags, FLAG_RANDOM)) {
+			zip->random = 1;
+		}
+	}
+}
+
+/** Take the next row of several ranges side by side.
+ *
+ * @param[in,out] zip
+ * @param[out] values One value per range
+ *
+ * @return 1 if values holds a row, 0 after the last row
+ *
+ * @since 1.2
+ */
+int range_zip_next(range_zip * zip, double * values) {
+	unsigned int i;
+
+	if (zip->done) {
+		return 0;
+	}
+
+	for (i = 0; i < zip->dimension_count; i++) {
+		if (enum_yield(zip->dimensions + i, values + i) != YIELD_MORE) {
+			zip->done = 1;
+		}
+	}
+	if (zip->limited && (--zip->left == 0)) {
+		zip->done = 1;
+	}
+	return 1;
+}
+
+/** Skip empty ranges of a concatenation.
+ *
+ * @param[in,out] concat
+ *
+ * @since 1.2
+ */
+static void skip_empty_ranges(range_concat * concat) {
+	for (; concat->index < concat->dimension_count; concat->index++) {
+		unsigned long count;
+
+		if (! count_values(concat->dimensions + concat->index, &count) || (count > 0)) {
+			return;
+		}
+	}
+	concat->done = 1;
+}
+
+/** Start a walk through several ranges one after another.
+ *
+ * @param[out] concat
+ * @param[in] dest Scaffolding with completed ranges
+ *
+ * @since 1.2
+ */
+void range_concat_init(range_concat * concat, scaffolding * dest) {
+	unsigned int i;
+
+	concat->dimensions = dest->dimensions;
+	concat->dimension_count = dest->dimension_count;
+	concat->index = 0;
+	concat->limited = CHECK_FLAG(dest->flags, FLAG_LIMIT_SET);
+	concat->left = dest->limit;
+	concat->finite = concat->limited
+		|| HAS_COUNT((dest->dimensions + dest->dimension_count - 1));
+	concat->random = 0;
+	concat->done = concat->limited && (dest->limit == 0);
+
+	for (i = 0; i < dest->dimension_count; i++) {
+		if (CHECK_FLAG(dest->dimensions[i].flags, FLAG_RANDOM)) {
+			concat->random = 1;
+		}
+	}
+	skip_empty_ranges(concat);
+}
+
+/** Take the next value of several ranges one after another.
+ *
+ * --limit=COUNT spans all ranges, as if they were a single range.
+ *
+ * @param[in,out] concat
+ * @param[out] value
+ * @param[out] index Index of the range value belongs to
+ *
+ * @return 1 if value has been set, 0 after the last value
+ *
+ * @since 1.2
+ */
+int range_concat_next(range_concat * concat, double * value, unsigned int * index) {
+	if (concat->done) {
+		return 0;
+	}
+
+	*index = concat->index;
+	if (enum_yield(concat->dimensions + concat->index, value) != YIELD_MORE) {
+		concat->index++;
+		skip_empty_ranges(concat);
+	}
+	if (concat->limited && (--concat->left == 0)) {
+		concat->done = 1;
+	}
+	return 1;
+}
@@ -0,0 +1,140 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RANGES_H
+#define RANGES_H 1
+
+#include "generator.h"
+
+/** Enumeration of possible return values of complete_ranges() and
+ * range_product_init()
+ *
+ * @since 1.2
+ */
+typedef enum _ranges_status {
+	RANGES_SUCCESS,
+	RANGES_SINGLE_RANGE_OPTION,   /**< option only applies to a single range */
+	RANGES_CONCAT_OPTION,         /**< option does not apply to --concat */
+	RANGES_SET_OPTION,            /**< option does not apply to set operations */
+	RANGES_SEQUENCE_OPTION,       /**< kind of sequence only applies to a single range */
+	RANGES_ZIP_ORDER,             /**< --zip given with --order */
+	RANGES_TOO_MANY_FORMATS,      /**< more --field-format than ranges */
+	RANGES_EXCEPT_WITHOUT_SET,    /**< --except given without set operation */
+	RANGES_SET_RANDOM,            /**< random range in a set operation */
+	RANGES_RANDOM_WITHOUT_ZIP,    /**< random range in a product */
+	RANGES_INNER_INFINITY,        /**< infinite range other than the first of a product */
+	RANGES_SET_DESCENDING_INFINITY, /**< infinite descending range in a set operation */
+	RANGES_SET_NOT_INTEGERS,      /**< values other than integers in a set operation */
+	RANGES_CONCAT_INFINITY,       /**< infinite range other than the last of --concat */
+	RANGES_ORDER_INFINITY,        /**< infinite range with --order */
+	RANGES_EQUAL_WIDTH_INFINITY,  /**< infinite range with -e|--equal-width */
+	RANGES_TOO_LARGE,             /**< ranges too large for --order */
+	RANGES_OUT_OF_MEMORY
+} ranges_status;
+
+/** Walk through the Cartesian product of several ranges
+ *
+ * Tuples are given as positions into each range, see walk.  The walk
+ * ends with the last tuple or after --limit=COUNT tuples.
+ *
+ * @since 1.2
+ */
+typedef struct _range_product {
+	scaffolding * dimensions;      /**< ranges, each completed */
+	unsigned int dimension_count;  /**< number of ranges */
+	tuple_walk walk;               /**< positions of current tuple (unless done at start) */
+	int walking;                   /**< whether walk has been started */
+	int finite;                    /**< whether the number of tuples is finite */
+	int done;                      /**< whether there is no current tuple */
+	int limited;                   /**< whether --limit=COUNT applies */
+	unsigned long left;            /**< number of tuples left with --limit=COUNT */
+} range_product;
+
+/** Walk through several ranges side by side
+ *
+ * Each row holds the next value of every range.  The walk ends with
+ * the shortest range or after --limit=COUNT rows.
+ *
+ * @since 1.2
+ */
+typedef struct _range_zip {
+	scaffolding * dimensions;      /**< ranges, each completed */
+	unsigned int dimension_count;  /**< number of ranges */
+	int finite;                    /**< whether the number of rows is finite */
+	int random;                    /**< whether any range draws random values */
+	int done;                      /**< whether there are no rows left */
+	int limited;                   /**< whether --limit=COUNT applies */
+	unsigned long left;            /**< number of rows left with --limit=COUNT */
+} range_zip;
+
+/** Walk through several ranges one after another
+ *
+ * Values of all ranges share --limit=COUNT, as if they came from a
+ * single range.
+ *
+ * @since 1.2
+ */
+typedef struct _range_concat {
+	scaffolding * dimensions;      /**< ranges, each completed */
+	unsigned int dimension_count;  /**< number of ranges */
+	unsigned int index;            /**< index of the current range */
+	int finite;                    /**< whether the number of values is finite */
+	int random;                    /**< whether any range draws random values */
+	int done;                      /**< whether there are no values left */
+	int limited;                   /**< whether --limit=COUNT applies */
+	unsigned long left;            /**< number of values left with --limit=COUNT */
+} range_concat;
+
+int split_at_commas(int reduced_argc, char ** reduced_argv, int attached,
+		int * new_argc, char *** new_argv);
+int make_progression(const scaffolding * range, progression * dest);
+ranges_status complete_ranges(scaffolding * dest);
+
+ranges_status range_product_init(range_product * product, scaffolding * dest);
+double range_product_value(range_product const * product, unsigned int index);
+int range_product_next(range_product * product);
+void range_product_free(range_product * product);
+
+void range_zip_init(range_zip * zip, scaffolding * dest);
+int range_zip_next(range_zip * zip, double * values);
+
+void range_concat_init(range_concat * concat, scaffolding * dest);
+int range_concat_next(range_concat * concat, double * value, unsigned int * index);
+
+#endif /* RANGES_H */
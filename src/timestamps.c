@@ -0,0 +1,596 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "timestamps.h"
+#include "assertion.h"
+
+#include <stdlib.h>  /* for malloc */
+#include <string.h>  /* for memcpy, strlen */
+#include <stdio.h>   /* for sprintf */
+#include <math.h>    /* for floor */
+
+/** Number of seconds per day
+ *
+ * @since 1.2
+ */
+#define SECONDS_PER_DAY  86400L
+
+/** @name Parts of time a field depends on
+ *
+ * @since 1.2
+ */
+/*@{*/
+#define TIME_DATE    (1 << 0)
+#define TIME_HOUR    (1 << 1)
+#define TIME_MINUTE  (1 << 2)
+#define TIME_SECOND  (1 << 3)
+#define TIME_EPOCH   (1 << 4)
+/*@}*/
+
+static const char * const weekday_names[7] = {
+	"Sunday", "Monday", "Tuesday", "Wednesday", "Thursday", "Friday", "Saturday"
+};
+
+static const char * const month_names[12] = {
+	"January", "February", "March", "April", "May", "June",
+	"July", "August", "September", "October", "November", "December"
+};
+
+/** Count days since 1970-01-01 of a civil date
+ *
+ * Follows H. Hinnant, "chrono-Compatible Low-Level Date Algorithms",
+ * counting in eras of 400 years, each 146097 days long.
+ *
+ * @param[in] year
+ * @param[in] month 1 to 12
+ * @param[in] day 1 to 31
+ *
+ * @return days since the epoch, negative before
+ *
+ * @since 1.2
+ */
+static long days_from_civil(long year, int month, int day) {
+	long era;
+	long year_of_era;
+	long day_of_year;
+	long day_of_era;
+
+	year -= (month <= 2);
+	era = ((year >= 0) ? year : year - 399) / 400;
+	year_of_era = year - era * 400;
+	day_of_year = (153 * ((month > 2) ? month - 3 : month + 9) + 2) / 5 + day - 1;
+	day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+	return era * 146097 + day_of_era - 719468;
+}
+
+/** Find the civil date of days since 1970-01-01
+ *
+ * The inverse of days_from_civil().
+ *
+ * @param[in] days
+ * @param[out] year
+ * @param[out] month 1 to 12
+ * @param[out] day 1 to 31
+ *
+ * @since 1.2
+ */
+static void civil_from_days(long days, long * year, int * month, int * day) {
+	const long shifted = days + 719468;
+	const long era = ((shifted >= 0) ? shifted : shifted - 146096) / 146097;
+	const long day_of_era = shifted - era * 146097;
+	const long year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524
+		- day_of_era / 146096) / 365;
+	const long day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4
+		- year_of_era / 100);
+	const long month_index = (5 * day_of_year + 2) / 153;
+
+	*day = (int)(day_of_year - (153 * month_index + 2) / 5 + 1);
+	*month = (int)((month_index < 10) ? month_index + 3 : month_index - 9);
+	*year = year_of_era + era * 400 + (*month <= 2);
+}
+
+/** Count days in a month
+ *
+ * @param[in] year
+ * @param[in] month 1 to 12
+ *
+ * @return number of days
+ *
+ * @since 1.2
+ */
+static int days_in_month(long year, int month) {
+	return (int)(days_from_civil(year + (month == 12), (month % 12) + 1, 1)
+		- days_from_civil(year, month, 1));
+}
+
+/** Read a fixed number of decimal digits
+ *
+ * @param[in,out] text Position to read from, advanced past the digits
+ * @param[in] digits Number of digits expected
+ * @param[out] value
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+static int read_digits(const char ** text, unsigned int digits, long * value) {
+	unsigned int i;
+
+	*value = 0;
+	for (i = 0; i < digits; i++) {
+		const char c = (*text)[i];
+		if ((c < '0') || (c > '9')) {
+			return 0;
+		}
+		*value = *value * 10 + (c - '0');
+	}
+	*text += digits;
+	return 1;
+}
+
+/** Parse an ISO 8601 instant into seconds since the epoch
+ *
+ * Accepted are "YYYY-MM-DD", optionally followed by "T" or a space and
+ * "HH:MM" or "HH:MM:SS", optionally followed by "Z" or an offset from
+ * UTC like "+02:00" or "-0530".  Instants without offset are taken as
+ * UTC.
+ *
+ * @param[in] text
+ * @param[out] seconds
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+int parse_instant(const char * text, double * seconds) {
+	long year;
+	long month;
+	long day;
+	long hour = 0;
+	long minute = 0;
+	long second = 0;
+	long offset = 0;
+
+	if (! read_digits(&text, 4, &year) || (*text++ != '-')
+			|| ! read_digits(&text, 2, &month) || (*text++ != '-')
+			|| ! read_digits(&text, 2, &day)
+			|| (month < 1) || (month > 12)
+			|| (day < 1) || (day > days_in_month(year, (int)month))) {
+		return 0;
+	}
+
+	if ((*text == 'T') || (*text == ' ')) {
+		text++;
+		if (! read_digits(&text, 2, &hour) || (*text++ != ':')
+				|| ! read_digits(&text, 2, &minute)) {
+			return 0;
+		}
+		if ((*text == ':') && (text++, ! read_digits(&text, 2, &second))) {
+			return 0;
+		}
+		if ((hour > 23) || (minute > 59) || (second > 59)) {
+			return 0;
+		}
+	}
+
+	if (*text == 'Z') {
+		text++;
+	} else if ((*text == '+') || (*text == '-')) {
+		const int sign = (*text++ == '-') ? -1 : +1;
+		long offset_hours;
+		long offset_minutes;
+
+		if (! read_digits(&text, 2, &offset_hours)) {
+			return 0;
+		}
+		if (*text == ':') {
+			text++;
+		}
+		if (! read_digits(&text, 2, &offset_minutes)
+				|| (offset_hours > 23) || (offset_minutes > 59)) {
+			return 0;
+		}
+		offset = sign * (offset_hours * 3600 + offset_minutes * 60);
+	}
+
+	if (*text != '\0') {
+		return 0;
+	}
+
+	*seconds = (double)days_from_civil(year, (int)month, (int)day) * SECONDS_PER_DAY
+		+ hour * 3600 + minute * 60 + second - offset;
+	return 1;
+}
+
+/** Parse an ISO 8601 duration into seconds
+ *
+ * Accepted are "PnW" and "PnDTnHnMnS" with any of the parts left out,
+ * e.g. "P1D", "PT15M" or "P1DT12H".  Years and months are rejected as
+ * their length varies.
+ *
+ * @param[in] text
+ * @param[out] seconds
+ *
+ * @return boolean meaning of 1 or 0
+ *
+ * @since 1.2
+ */
+int parse_duration(const char * text, double * seconds) {
+	const char * const units = "WDHMS";
+	const double unit_seconds[5] = {7 * 86400.0, 86400.0, 3600.0, 60.0, 1.0};
+	int in_time = 0;
+	int parts = 0;
+	unsigned int last_unit = 0;
+	double total = 0;
+
+	if (*text++ != 'P') {
+		return 0;
+	}
+
+	while (*text != '\0') {
+		double number = 0;
+		unsigned int digits = 0;
+		const char * unit;
+		unsigned int index;
+
+		if ((*text == 'T') && ! in_time) {
+			in_time = 1;
+			last_unit = 2;
+			text++;
+			continue;
+		}
+
+		for (; (*text >= '0') && (*text <= '9'); text++, digits++) {
+			number = number * 10 + (*text - '0');
+		}
+		unit = (*text != '\0') ? strchr(units, *text) : NULL;
+		if ((digits == 0) || ! unit) {
+			return 0;
+		}
+		index = (unsigned int)(unit - units);
+
+		/* Units in order, date units before "T", time units after */
+		if ((index < last_unit) || (in_time != (index >= 2))
+				|| ((index == 0) && (parts > 0))) {
+			return 0;
+		}
+		last_unit = index + 1;
+		total += number * unit_seconds[index];
+		parts++;
+		text++;
+	}
+
+	if (parts == 0) {
+		return 0;
+	}
+	*seconds = total;
+	return 1;
+}
+
+/** Write a non-negative number with a fixed number of digits
+ *
+ * @param[out] dest
+ * @param[in] value
+ * @param[in] width Number of digits
+ * @param[in] pad Character to pad leading zeros with, e.g. '0' or ' '
+ *
+ * @return number of characters written
+ *
+ * @since 1.2
+ */
+static size_t put_digits(char * dest, long value, unsigned int width, char pad) {
+	unsigned int i;
+
+	for (i = width; i > 0; i--) {
+		dest[i - 1] = (char)('0' + value % 10);
+		value /= 10;
+	}
+	for (i = 0; (i + 1 < width) && (dest[i] == '0'); i++) {
+		dest[i] = pad;
+	}
+	return width;
+}
+
+/** Tell which parts of time a field depends on
+ *
+ * @param[in] specifier
+ *
+ * @return parts of time, zero for unsupported specifiers
+ *
+ * @since 1.2
+ */
+static int field_depends(char specifier) {
+	switch (specifier) {
+	case 'Y': case 'y': case 'm': case 'd': case 'e': case 'j':
+	case 'F': case 'a': case 'A': case 'b': case 'B': case 'u': case 'w':
+		return TIME_DATE;
+	case 'H':
+		return TIME_HOUR;
+	case 'M':
+		return TIME_MINUTE;
+	case 'S':
+		return TIME_SECOND;
+	case 'T':
+		return TIME_HOUR | TIME_MINUTE | TIME_SECOND;
+	case 's':
+		return TIME_EPOCH;
+	default:
+		return 0;
+	}
+}
+
+/** Render a field of the current timestamp
+ *
+ * @param[in] formatter
+ * @param[in,out] piece
+ *
+ * @since 1.2
+ */
+static void render_field(const time_formatter * formatter, time_piece * piece) {
+	char * const text = piece->text;
+
+	switch (piece->specifier) {
+	case 'Y':
+		if ((formatter->year >= 0) && (formatter->year <= 9999)) {
+			piece->length = put_digits(text, formatter->year, 4, '0');
+		} else {
+			piece->length = (size_t)sprintf(text, "%ld", formatter->year);
+		}
+		break;
+	case 'y':
+		piece->length = put_digits(text, ((formatter->year % 100) + 100) % 100, 2, '0');
+		break;
+	case 'm':
+		piece->length = put_digits(text, formatter->month, 2, '0');
+		break;
+	case 'd':
+		piece->length = put_digits(text, formatter->day, 2, '0');
+		break;
+	case 'e':
+		piece->length = put_digits(text, formatter->day, 2, ' ');
+		break;
+	case 'j':
+		piece->length = put_digits(text, formatter->day_of_year, 3, '0');
+		break;
+	case 'F':
+		piece->length = (size_t)sprintf(text, "%04ld-%02d-%02d",
+			formatter->year, formatter->month, formatter->day);
+		break;
+	case 'a':
+		memcpy(text, weekday_names[formatter->weekday], 3);
+		piece->length = 3;
+		break;
+	case 'A':
+		piece->length = strlen(weekday_names[formatter->weekday]);
+		memcpy(text, weekday_names[formatter->weekday], piece->length);
+		break;
+	case 'b':
+		memcpy(text, month_names[formatter->month - 1], 3);
+		piece->length = 3;
+		break;
+	case 'B':
+		piece->length = strlen(month_names[formatter->month - 1]);
+		memcpy(text, month_names[formatter->month - 1], piece->length);
+		break;
+	case 'u':
+		piece->length = put_digits(text, (formatter->weekday == 0) ? 7 : formatter->weekday, 1, '0');
+		break;
+	case 'w':
+		piece->length = put_digits(text, formatter->weekday, 1, '0');
+		break;
+	case 'H':
+		piece->length = put_digits(text, formatter->hour, 2, '0');
+		break;
+	case 'M':
+		piece->length = put_digits(text, formatter->minute, 2, '0');
+		break;
+	case 'S':
+		piece->length = put_digits(text, formatter->second, 2, '0');
+		break;
+	case 'T':
+		put_digits(text, formatter->hour, 2, '0');
+		text[2] = ':';
+		put_digits(text + 3, formatter->minute, 2, '0');
+		text[5] = ':';
+		put_digits(text + 6, formatter->second, 2, '0');
+		piece->length = 8;
+		break;
+	case 's':
+		piece->length = (size_t)sprintf(text, "%.0f", formatter->seconds);
+		break;
+	default:
+		assert(0);
+	}
+}
+
+/** Prepare rendering timestamps in given format
+ *
+ * Supported fields are %Y, %y, %m, %d, %e, %j, %F, %a, %A, %b, %B, %u,
+ * %w, %H, %M, %S, %T and %s like with strftime(3) in the C locale, and
+ * %% for a percent sign.  Times are rendered in UTC.
+ *
+ * @param[out] formatter
+ * @param[in] format
+ *
+ * @return status
+ *
+ * @since 1.2
+ */
+time_format_status time_formatter_init(time_formatter * formatter,
+		const char * format) {
+	const size_t format_length = strlen(format);
+	size_t capacity = 0;
+	char * write;
+	const char * read;
+
+	formatter->piece_count = 0;
+	formatter->started = 0;
+	formatter->length = 0;
+	formatter->pieces = (time_piece *)malloc((format_length + 1) * sizeof(time_piece));
+	formatter->literals = (char *)malloc(format_length + 1);
+	formatter->line = NULL;
+	if (! formatter->pieces || ! formatter->literals) {
+		time_formatter_free(formatter);
+		return TIME_FORMAT_OUT_OF_MEMORY;
+	}
+
+	write = formatter->literals;
+	for (read = format; *read != '\0'; ) {
+		time_piece * const piece = formatter->pieces + formatter->piece_count;
+
+		if ((read[0] == '%') && (read[1] != '%')) {
+			piece->specifier = read[1];
+			piece->depends = field_depends(read[1]);
+			if (piece->depends == 0) {
+				time_formatter_free(formatter);
+				return TIME_FORMAT_INVALID;
+			}
+			piece->length = 0;
+			capacity += TIME_FIELD_SIZE;
+			read += 2;
+		} else {
+			/* Literal text up to the next field */
+			piece->specifier = '\0';
+			piece->depends = 0;
+			piece->literal = write;
+			while ((*read != '\0') && ! ((read[0] == '%') && (read[1] != '%'))) {
+				*write++ = *read;
+				read += (read[0] == '%') ? 2 : 1;
+			}
+			piece->length = (size_t)(write - piece->literal);
+			capacity += piece->length;
+		}
+		formatter->piece_count++;
+	}
+
+	formatter->line = (char *)malloc(capacity + 1);
+	if (! formatter->line) {
+		time_formatter_free(formatter);
+		return TIME_FORMAT_OUT_OF_MEMORY;
+	}
+	return TIME_FORMAT_SUCCESS;
+}
+
+/** Render a timestamp into formatter->line
+ *
+ * Fields depending on parts of time that did not change are kept from
+ * the previous timestamp.  Fields keeping their length are rewritten in
+ * place; otherwise, the line is put together again.
+ *
+ * @param[in,out] formatter
+ * @param[in] seconds Seconds since the epoch, fractions are dropped
+ *
+ * @since 1.2
+ */
+void time_formatter_render(time_formatter * formatter, double seconds) {
+	const double whole = floor(seconds);
+	const long days = (long)floor(whole / SECONDS_PER_DAY);
+	const long second_of_day = (long)(whole - (double)days * SECONDS_PER_DAY);
+	const int hour = (int)(second_of_day / 3600);
+	const int minute = (int)(second_of_day / 60 % 60);
+	const int second = (int)(second_of_day % 60);
+	int changed = TIME_EPOCH;
+	int relayout = ! formatter->started;
+	unsigned int i;
+
+	if (! formatter->started || (days != formatter->days)) {
+		civil_from_days(days, &formatter->year, &formatter->month, &formatter->day);
+		formatter->day_of_year = (int)(days - days_from_civil(formatter->year, 1, 1)) + 1;
+		formatter->weekday = (int)(((days % 7) + 11) % 7);
+		formatter->days = days;
+		changed |= TIME_DATE;
+	}
+	if (! formatter->started || (hour != formatter->hour)) {
+		formatter->hour = hour;
+		changed |= TIME_HOUR;
+	}
+	if (! formatter->started || (minute != formatter->minute)) {
+		formatter->minute = minute;
+		changed |= TIME_MINUTE;
+	}
+	if (! formatter->started || (second != formatter->second)) {
+		formatter->second = second;
+		changed |= TIME_SECOND;
+	}
+	formatter->seconds = whole;
+	formatter->started = 1;
+
+	for (i = 0; i < formatter->piece_count; i++) {
+		time_piece * const piece = formatter->pieces + i;
+
+		if (piece->depends & changed) {
+			const size_t previous_length = piece->length;
+
+			render_field(formatter, piece);
+			if (piece->length != previous_length) {
+				relayout = 1;
+			} else if (! relayout) {
+				memcpy(formatter->line + piece->offset, piece->text, piece->length);
+			}
+		}
+	}
+
+	if (relayout) {
+		formatter->length = 0;
+		for (i = 0; i < formatter->piece_count; i++) {
+			time_piece * const piece = formatter->pieces + i;
+
+			piece->offset = formatter->length;
+			memcpy(formatter->line + formatter->length,
+				(piece->specifier == '\0') ? piece->literal : piece->text,
+				piece->length);
+			formatter->length += piece->length;
+		}
+	}
+}
+
+/** Free memory held by a time formatter
+ *
+ * @param[in,out] formatter
+ *
+ * @since 1.2
+ */
+void time_formatter_free(time_formatter * formatter) {
+	free(formatter->pieces);
+	free(formatter->literals);
+	free(formatter->line);
+	formatter->pieces = NULL;
+	formatter->literals = NULL;
+	formatter->line = NULL;
+}
@@ -0,0 +1,115 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TIMESTAMPS_H
+#define TIMESTAMPS_H 1
+
+#include <stddef.h>  /* for size_t */
+
+/** Format of timestamps unless given by the user, ISO 8601 in UTC
+ *
+ * @since 1.2
+ */
+#define DEFAULT_TIME_FORMAT  "%Y-%m-%dT%H:%M:%SZ"
+
+/** Number of bytes reserved for the text of a single field
+ *
+ * @since 1.2
+ */
+#define TIME_FIELD_SIZE  24
+
+/** Piece of a time format, either literal text or a field
+ *
+ * @since 1.2
+ */
+typedef struct _time_piece {
+	char specifier;        /**< field specifier, e.g. 'Y', or '\0' for literal text */
+	int depends;           /**< parts of time the text depends on (fields only) */
+	const char * literal;  /**< literal text (literal text only) */
+	size_t length;         /**< length of text */
+	size_t offset;         /**< position of text in rendered line */
+	char text[TIME_FIELD_SIZE]; /**< rendered text (fields only) */
+} time_piece;
+
+/** State of rendering timestamps, one after another
+ *
+ * Each timestamp is split into days since the epoch and seconds of
+ * the day.  Fields are only rendered again if the parts of time they
+ * depend on changed since the previous timestamp.
+ *
+ * @since 1.2
+ */
+typedef struct _time_formatter {
+	time_piece * pieces;       /**< pieces of the format */
+	unsigned int piece_count;  /**< number of pieces */
+	char * literals;           /**< storage of literal text */
+	char * line;               /**< rendered timestamp */
+	size_t length;             /**< length of rendered timestamp */
+	int started;               /**< non-zero once a timestamp was rendered */
+	double seconds;            /**< previous timestamp, seconds since the epoch */
+	long days;                 /**< previous days since the epoch */
+	long year;                 /**< previous civil year */
+	int month;                 /**< previous month, 1 to 12 */
+	int day;                   /**< previous day of month, 1 to 31 */
+	int day_of_year;           /**< previous day of year, 1 to 366 */
+	int weekday;               /**< previous day of week, 0 (Sunday) to 6 */
+	int hour;                  /**< previous hour, 0 to 23 */
+	int minute;                /**< previous minute, 0 to 59 */
+	int second;                /**< previous second, 0 to 59 */
+} time_formatter;
+
+/** Enumeration of possible return values of time_formatter_init()
+ *
+ * @since 1.2
+ */
+typedef enum _time_format_status {
+	TIME_FORMAT_SUCCESS,
+	TIME_FORMAT_INVALID,       /**< unsupported field specifier */
+	TIME_FORMAT_OUT_OF_MEMORY
+} time_format_status;
+
+int parse_instant(const char * text, double * seconds);
+int parse_duration(const char * text, double * seconds);
+
+time_format_status time_formatter_init(time_formatter * formatter,
+		const char * format);
+void time_formatter_render(time_formatter * formatter, double seconds);
+void time_formatter_free(time_formatter * formatter);
+
+#endif /* TIMESTAMPS_H */
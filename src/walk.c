@@ -0,0 +1,148 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "walk.h"
+#include "random.h"
+
+#include <math.h>  /* for fabs, floor */
+
+/** Prepare a random walk
+ *
+ * @param[out] walk
+ * @param[in] type Kind of increments
+ * @param[in] start First value
+ * @param[in] step Size of increments, sign ignored
+ * @param[in] bounded Whether to keep values between start and end
+ * @param[in] end Other bound of values (if bounded)
+ *
+ * @since 1.2
+ */
+void random_walk_init(random_walk * walk, walk_type type, double start,
+		double step, int bounded, double end) {
+	double span = end - start;
+
+	walk->type = type;
+	walk->start = start;
+	walk->step = fabs(step);
+	walk->bounded = bounded;
+	walk->position = 0;
+	walk->bits = 0;
+	walk->bits_left = 0;
+	walk->started = 0;
+
+	/* Values on the grid only */
+	if ((type == WALK_STEP) && (walk->step > 0)) {
+		span = (span < 0)
+			? -floor(-span / walk->step + 1e-9)
+			: floor(span / walk->step + 1e-9);
+	}
+	walk->low = (span < 0) ? span : 0;
+	walk->high = (span < 0) ? 0 : span;
+}
+
+/** Produce the next values of a random walk
+ *
+ * All increments of the batch are drawn first, then summed up in a
+ * second pass.  The first value produced is the start itself.
+ *
+ * @param[in,out] walk
+ * @param[out] dest
+ * @param[in] count Number of values wanted
+ *
+ * @since 1.2
+ */
+void random_walk_batch(random_walk * walk, double * dest, size_t count) {
+	double position = walk->position;
+	size_t i;
+
+	switch (walk->type) {
+	case WALK_STEP:
+		/* One random bit per step */
+		for (i = 0; i < count; i++) {
+			if (walk->bits_left == 0) {
+				walk->bits = enum_random_bits();
+				walk->bits_left = 32;
+			}
+			dest[i] = (walk->bits & 1) ? 1.0 : -1.0;
+			walk->bits >>= 1;
+			walk->bits_left--;
+		}
+		break;
+	case WALK_UNIFORM:
+		for (i = 0; i < count; i++) {
+			dest[i] = (2 * enum_random_uniform() - 1) * walk->step;
+		}
+		break;
+	default:
+		for (i = 0; i < count; i++) {
+			dest[i] = enum_random_normal() * walk->step;
+		}
+		break;
+	}
+
+	if (! walk->started && (count > 0)) {
+		dest[0] = 0;
+		walk->started = 1;
+	}
+
+	/* Running sum of increments */
+	if (walk->bounded) {
+		for (i = 0; i < count; i++) {
+			position += dest[i];
+			if (position < walk->low) {
+				position = walk->low;
+			} else if (position > walk->high) {
+				position = walk->high;
+			}
+			dest[i] = position;
+		}
+	} else {
+		for (i = 0; i < count; i++) {
+			position += dest[i];
+			dest[i] = position;
+		}
+	}
+	walk->position = position;
+
+	for (i = 0; i < count; i++) {
+		dest[i] = (walk->type == WALK_STEP)
+			? walk->start + dest[i] * walk->step
+			: walk->start + dest[i];
+	}
+}
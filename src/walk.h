@@ -0,0 +1,86 @@
+/*
+ * enum - seq- and jot-like enumerator
+ *
+ * Copyright (C) 2010-2012, Jan Hauke Rahm <jhr@debian.org>
+ * Copyright (C) 2010-2012, Sebastian Pipping <sping@gentoo.org>
+ * All rights reserved.
+ *
+ * Redistribution  and use in source and binary forms, with or without
+ * modification,  are permitted provided that the following conditions
+ * are met:
+ *
+ *     * Redistributions   of  source  code  must  retain  the   above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer.
+ *
+ *     * Redistributions  in  binary  form must  reproduce  the  above
+ *       copyright  notice, this list of conditions and the  following
+ *       disclaimer   in  the  documentation  and/or  other  materials
+ *       provided with the distribution.
+ *
+ *     * Neither  the name of the <ORGANIZATION> nor the names of  its
+ *       contributors  may  be  used to endorse  or  promote  products
+ *       derived  from  this software without specific  prior  written
+ *       permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS  IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT  NOT
+ * LIMITED  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND  FITNESS
+ * FOR  A  PARTICULAR  PURPOSE ARE DISCLAIMED. IN NO EVENT  SHALL  THE
+ * COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL,    SPECIAL,   EXEMPLARY,   OR   CONSEQUENTIAL   DAMAGES
+ * (INCLUDING,  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES;  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT  LIABILITY,  OR  TORT (INCLUDING  NEGLIGENCE  OR  OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ * OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef WALK_H
+#define WALK_H 1
+
+#include <stddef.h>  /* for size_t */
+
+/** Number of values of a random walk produced at once
+ *
+ * @since 1.2
+ */
+#define WALK_BATCH_SIZE  1024
+
+/** Enumeration of kinds of increments of a random walk
+ *
+ * @since 1.2
+ */
+typedef enum _walk_type {
+	WALK_NONE,     /**< no random walk (default) */
+	WALK_STEP,     /**< one step up or down the grid */
+	WALK_UNIFORM,  /**< uniform between minus step and step */
+	WALK_NORMAL    /**< normal with step as standard deviation */
+} walk_type;
+
+/** State of a random walk
+ *
+ * The position is kept relative to the start, in steps for WALK_STEP
+ * so that values stay on the grid exactly.
+ *
+ * @since 1.2
+ */
+typedef struct _random_walk {
+	walk_type type;        /**< kind of increments */
+	double start;          /**< first value */
+	double step;           /**< size of increments, positive */
+	int bounded;           /**< whether positions are clamped to low and high */
+	double low;            /**< lowest position (if bounded) */
+	double high;           /**< highest position (if bounded) */
+	double position;       /**< position of previous value */
+	unsigned long bits;    /**< random bits left over (WALK_STEP) */
+	unsigned int bits_left; /**< number of bits in bits */
+	int started;           /**< non-zero once the first value was produced */
+} random_walk;
+
+void random_walk_init(random_walk * walk, walk_type type, double start,
+		double step, int bounded, double end);
+void random_walk_batch(random_walk * walk, double * dest, size_t count);
+
+#endif /* WALK_H */
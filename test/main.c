@@ -38,11 +38,28 @@
  */
 
 #include "../src/generator.h"
+#include "../src/chacha20.h"
+#include "../src/choice.h"
+#include "../src/blake3.h"
+#include "../src/ordering.h"
+#include "../src/progression.h"
+#include "../src/timestamps.h"
+#include "../src/alphabet.h"
+#include "../src/primes.h"
+#include "../src/quasi.h"
+#include "../src/input.h"
+#include "../src/walk.h"
+#include "../src/printing.h"
+#include "../src/prediction.h"
+#include "../src/ranges.h"
 #include "../src/assertion.h"
 
 #include <stdio.h>
+#include <stdlib.h> /* for free */
 #include <math.h> /* for fabs */
 #include <string.h> /* for strncmp */
+#include <unistd.h> /* for pipe */
+#include <limits.h> /* for ULONG_MAX */
 #include "utils.h"
 
 #define ARRAY(numbers...)  { numbers }
@@ -94,33 +111,37 @@ int towards_infinity(scaffolding const * scaffold) {
 	return ((scaffold->flags & (FLAG_RIGHT_SET | FLAG_COUNT_SET)) != (FLAG_RIGHT_SET | FLAG_COUNT_SET));
 }
 
-int test_yield(float left, unsigned int count, float step, float right, const float * expected, unsigned int exp_len) {
-	scaffolding scaffold;
-	float dest;
-	unsigned int i;
-	int ret = 1;
-
-	pseudo_call(left, count, step, right);
-
-	initialize_scaffold(&scaffold);
+void setup_scaffold(scaffolding * scaffold, float left, unsigned int count, float step, float right) {
+	initialize_scaffold(scaffold);
 
 	if (left != XX) {
-		SET_LEFT(scaffold, left);
+		SET_LEFT(*scaffold, left);
 	}
 
 	if (count != XX) {
-		SET_COUNT(scaffold, count);
+		SET_COUNT(*scaffold, count);
 	}
 
 	if (step != XX) {
-		SET_STEP(scaffold, step);
-		scaffold.flags |= FLAG_USER_STEP;
+		SET_STEP(*scaffold, step);
+		scaffold->flags |= FLAG_USER_STEP;
 	}
 
 	if (right != XX) {
-		SET_RIGHT(scaffold, right);
+		SET_RIGHT(*scaffold, right);
 	}
+}
 
+int test_yield(float left, unsigned int count, float step, float right, const float * expected, unsigned int exp_len) {
+	scaffolding scaffold;
+	double dest;
+	unsigned long total;
+	unsigned int i;
+	int ret = 1;
+
+	pseudo_call(left, count, step, right);
+
+	setup_scaffold(&scaffold, left, count, step, right);
 	complete_scaffold(&scaffold);
 
 	puts(TEST_CASE_INDENT "    Received  Expected");
@@ -161,7 +182,12 @@ int test_yield(float left, unsigned int count, float step, float right, const fl
 
 	if (! towards_infinity(&scaffold)) {
 		if (scaffold.count != exp_len) {
-			printf(TEST_CASE_INDENT "FAILURE (count miscalculated, expected: %d, calculated: %d)\n", exp_len, scaffold.count);
+			printf(TEST_CASE_INDENT "FAILURE (count miscalculated, expected: %u, calculated: %lu)\n", exp_len, scaffold.count);
+			ret = 0;
+		}
+
+		if (! count_values(&scaffold, &total) || (total != exp_len)) {
+			printf(TEST_CASE_INDENT "FAILURE (count_values mismatch, expected: %u)\n", exp_len);
 			ret = 0;
 		}
 	}
@@ -242,6 +268,1357 @@ void test_unescape() {
 	UNESCAPE_TEST("\\\\\\", "\\\\");
 }
 
+#define DISTRIBUTION_TEST(type, argc, arg0, arg1, expected_mean) \
+	distribution_test(type, argc, arg0, arg1, expected_mean, #type)
+
+
+void distribution_test(distribution_type type, unsigned int argc, float arg0, float arg1,
+		float expected_mean, const char * name) {
+	const unsigned int count = 20000;
+	scaffolding scaffold;
+	double dest;
+	double sum = 0;
+	unsigned int i;
+
+	initialize_scaffold(&scaffold);
+	scaffold.flags |= FLAG_RANDOM;
+	scaffold.distribution = type;
+	scaffold.distribution_argc = argc;
+	scaffold.distribution_args[0] = arg0;
+	scaffold.distribution_args[1] = arg1;
+	SET_LEFT(scaffold, 0);
+	SET_COUNT(scaffold, count);
+	SET_STEP(scaffold, 0.5);
+	SET_RIGHT(scaffold, 20);
+	complete_scaffold(&scaffold);
+
+	enum_random_seed(1234);
+	for (i = 0; i < count; i++) {
+		enum_yield(&scaffold, &dest);
+
+		/* Within range and on the grid? */
+		assert((dest >= 0) && (dest <= 20));
+		assert(fabs(dest * 2 - floor(dest * 2 + 0.5)) < FLOAT_EQUAL_DELTA);
+		sum += dest;
+	}
+
+	printf("# %s: mean %.3f, expected %.3f\n", name, sum / count, expected_mean);
+	assert(fabs(sum / count - expected_mean) < 0.1);
+}
+
+
+void test_distributions() {
+	DISTRIBUTION_TEST(DISTRIBUTION_UNIFORM, 0, 0, 0, 10);
+	DISTRIBUTION_TEST(DISTRIBUTION_NORMAL, 0, 0, 0, 10);
+	DISTRIBUTION_TEST(DISTRIBUTION_NORMAL, 2, 7, 1, 7);
+	DISTRIBUTION_TEST(DISTRIBUTION_EXPONENTIAL, 1, 0.5, 0, 2);
+	DISTRIBUTION_TEST(DISTRIBUTION_LOG_NORMAL, 2, 1, 0.25, 2.8);
+	DISTRIBUTION_TEST(DISTRIBUTION_ZIPF, 1, 2, 0, 0.827);
+}
+
+void test_random_text() {
+	/* Masking for 2^k characters, rejection otherwise */
+	const char * const alphabets[] = {"01234567", "abc"};
+	unsigned int counts[8];
+	char text[30000];
+	unsigned int i;
+	unsigned int j;
+
+	enum_random_seed(1234);
+	for (i = 0; i < 2; i++) {
+		const size_t size = strlen(alphabets[i]);
+
+		for (j = 0; j < size; j++) {
+			counts[j] = 0;
+		}
+		enum_random_text(text, sizeof(text), alphabets[i], size);
+		for (j = 0; j < sizeof(text); j++) {
+			const char * const found = strchr(alphabets[i], text[j]);
+			assert(found && (text[j] != '\0'));
+			counts[found - alphabets[i]]++;
+		}
+		for (j = 0; j < size; j++) {
+			assert(fabs(counts[j] * (double)size / sizeof(text) - 1) < 0.05);
+		}
+	}
+}
+
+void test_alias_table() {
+	const double weights[] = {1, 0, 3, 4, 0.5};
+	const unsigned int draws = 85000;
+	unsigned int counts[5] = {0, 0, 0, 0, 0};
+	alias_table table;
+	unsigned int i;
+
+	/* All weights zero */
+	assert(alias_table_init(&table, weights + 1, 1) == CHOICE_INVALID_WEIGHT);
+
+	assert(alias_table_init(&table, weights, 5) == CHOICE_SUCCESS);
+	enum_random_seed(1234);
+	for (i = 0; i < draws; i++) {
+		counts[alias_table_draw(&table)]++;
+	}
+	alias_table_free(&table);
+
+	assert(counts[1] == 0);
+	for (i = 0; i < 5; i++) {
+		assert(fabs(counts[i] / (double)draws - weights[i] / 8.5) < 0.01);
+	}
+}
+
+void test_walk() {
+	double values[WALK_BATCH_SIZE];
+	random_walk walk;
+	scaffolding scaffold;
+	unsigned long count = 0;
+	unsigned int i;
+
+	/* Steps on the grid, clamped to 5 down to 3.5 */
+	enum_random_seed(1234);
+	random_walk_init(&walk, WALK_STEP, 5, -0.5, 1, 3.2);
+	random_walk_batch(&walk, values, 10);
+	random_walk_batch(&walk, values + 10, WALK_BATCH_SIZE - 10);
+	assert(values[0] == 5);
+	for (i = 1; i < WALK_BATCH_SIZE; i++) {
+		assert((values[i] >= 3.5) && (values[i] <= 5));
+		assert(fabs(values[i] - values[i - 1]) <= 0.5);
+		assert(fabs(values[i] * 2 - floor(values[i] * 2 + 0.5)) < FLOAT_EQUAL_DELTA);
+	}
+
+	/* Unbounded uniform increments */
+	random_walk_init(&walk, WALK_UNIFORM, 0, 2, 0, 0);
+	random_walk_batch(&walk, values, WALK_BATCH_SIZE);
+	assert(values[0] == 0);
+	for (i = 1; i < WALK_BATCH_SIZE; i++) {
+		assert(fabs(values[i] - values[i - 1]) < 2);
+	}
+
+	/* Count given along with right: right only clamps */
+	setup_scaffold(&scaffold, 50, 1000, 0.5, 100);
+	scaffold.walk = WALK_NORMAL;
+	complete_scaffold(&scaffold);
+	assert(count_window(&scaffold, &count));
+	assert(count == 1000);
+
+	setup_scaffold(&scaffold, 0, 20, 0.5, 2);
+	scaffold.walk = WALK_STEP;
+	complete_scaffold(&scaffold);
+	assert(count_values(&scaffold, &count));
+	assert(count == 20);
+}
+
+void window_test(float left, unsigned int count, float step, float right) {
+	const unsigned long max_len = 40;
+	const int finite = (right != XX) || (count != XX);
+	scaffolding scaffold;
+	double full[40];
+	double dest;
+	unsigned long full_len = 0;
+	unsigned long total = 0;
+	unsigned long skip;
+	unsigned long limit;
+	unsigned long i;
+	yield_status status = YIELD_MORE;
+
+	setup_scaffold(&scaffold, left, count, step, right);
+	complete_scaffold(&scaffold);
+	while ((status == YIELD_MORE) && (full_len < max_len)) {
+		status = enum_yield(&scaffold, &full[full_len]);
+		full_len++;
+	}
+	assert(count_values(&scaffold, &total) == finite);
+	if (finite) {
+		assert(total == full_len);
+	}
+	for (i = 0; i < full_len; i++) {
+		unsigned long position = full_len;
+		assert(fabs(value_at_position(&scaffold, i) - full[i]) < FLOAT_EQUAL_DELTA);
+		assert(position_of_value(&scaffold, full[i], &position));
+		assert(fabs(full[position] - full[i]) < FLOAT_EQUAL_DELTA);
+	}
+	if (finite && (full_len > 1)) {
+		/* Right in between two values, and beyond the last one */
+		assert(! position_of_value(&scaffold, (full[0] + full[1]) / 2, &i));
+		assert(! position_of_value(&scaffold,
+			2 * full[full_len - 1] - full[full_len - 2], &i));
+	}
+
+	for (skip = 0; skip < full_len + 2; skip++) {
+		for (limit = 0; limit < 5; limit++) {
+			setup_scaffold(&scaffold, left, count, step, right);
+			scaffold.skip = skip;
+			scaffold.limit = limit;
+			scaffold.flags |= FLAG_LIMIT_SET;
+			complete_scaffold(&scaffold);
+
+			/* Empty windows are caught before calling enum_yield */
+			if ((limit == 0) || (finite && (skip >= total))
+					|| (! finite && (skip + limit > full_len))) {
+				continue;
+			}
+
+			for (i = skip; ; i++) {
+				assert(i < full_len);
+				status = enum_yield(&scaffold, &dest);
+				assert(fabs(dest - full[i]) < FLOAT_EQUAL_DELTA);
+				if (status == YIELD_LAST) {
+					break;
+				}
+			}
+			assert((i - skip + 1 == limit) || (i + 1 == total));
+		}
+	}
+}
+
+
+void test_window() {
+	scaffolding scaffold;
+	double dest;
+
+	window_test( 2,  4,  3, 11);
+	window_test(XX,  4,  3, 11);
+	window_test( 2, XX,  3, 11);
+	window_test( 2,  4, XX, 11);
+	window_test( 2,  4,  3, XX);
+	window_test(XX, XX,  3, 11);
+	window_test(XX,  4, XX, 11);
+	window_test(XX,  4,  3, XX);
+	window_test( 2, XX, XX, 11);
+	window_test( 2, XX,  3, XX);
+	window_test( 2,  4, XX, XX);
+	window_test( 2, XX, XX, XX);
+	window_test(XX,  4, XX, XX);
+	window_test(XX, XX,  3, XX);
+	window_test(XX, XX, XX, 11);
+
+	/* Right reached before count, and tolerance around right */
+	window_test( 1, 10,  2,  6);
+	window_test( 1, 10,  2,  5);
+	window_test( 5,  3,  2,  5);
+	window_test( 0, XX, 0.1, 0.3);
+	window_test(0.7, XX, -0.1, 0.3);
+	window_test( 1, XX, 0.3, 2.00005);
+
+	/* Infinite ranges end at the last position instead of wrapping */
+	setup_scaffold(&scaffold, 1, XX, XX, XX);
+	scaffold.skip = ULONG_MAX - 2;
+	complete_scaffold(&scaffold);
+	assert(enum_yield(&scaffold, &dest) == YIELD_MORE);
+	assert(enum_yield(&scaffold, &dest) == YIELD_MORE);
+	assert(enum_yield(&scaffold, &dest) == YIELD_LAST);
+	assert(dest == (double)ULONG_MAX);
+}
+
+void shard_test(float left, unsigned int count, float step, float right, unsigned long skip) {
+	scaffolding scaffold;
+	unsigned long total;
+	unsigned long shard_count;
+	unsigned long shard_index;
+
+	setup_scaffold(&scaffold, left, count, step, right);
+	complete_scaffold(&scaffold);
+	assert(count_values(&scaffold, &total));
+	total = (skip < total) ? total - skip : 0;
+
+	for (shard_count = 1; shard_count <= 6; shard_count++) {
+		unsigned long expected_skip = skip;
+		for (shard_index = 1; shard_index <= shard_count; shard_index++) {
+			setup_scaffold(&scaffold, left, count, step, right);
+			scaffold.skip = skip;
+			scaffold.shard_index = shard_index;
+			scaffold.shard_count = shard_count;
+			complete_scaffold(&scaffold);
+
+			/* Contiguous, balanced, larger slices last */
+			assert(scaffold.skip == expected_skip);
+			assert(scaffold.position == scaffold.skip);
+			assert(CHECK_FLAG(scaffold.flags, FLAG_LIMIT_SET));
+			assert((scaffold.limit == total / shard_count)
+				|| (scaffold.limit == total / shard_count + 1));
+			assert((scaffold.limit == total / shard_count)
+				== (shard_index <= shard_count - total % shard_count));
+			expected_skip += scaffold.limit;
+		}
+		assert(expected_skip == skip + total);
+	}
+}
+
+
+void reverse_test(float left, unsigned int count, float step, float right) {
+	scaffolding scaffold;
+	double full[40];
+	double dest;
+	unsigned long total;
+	unsigned long position;
+	unsigned long i;
+
+	setup_scaffold(&scaffold, left, count, step, right);
+	complete_scaffold(&scaffold);
+	assert(count_values(&scaffold, &total) && (total <= 40));
+	for (i = 0; i < total; i++) {
+		enum_yield(&scaffold, &full[i]);
+	}
+
+	setup_scaffold(&scaffold, left, count, step, right);
+	scaffold.flags |= FLAG_REVERSE;
+	complete_scaffold(&scaffold);
+	for (i = 0; i < total; i++) {
+		const yield_status status = enum_yield(&scaffold, &dest);
+		assert(fabs(dest - full[total - 1 - i]) < FLOAT_EQUAL_DELTA);
+		assert((status == YIELD_LAST) == (i == total - 1));
+		assert(position_of_value(&scaffold, dest, &position) && (position == i));
+	}
+}
+
+
+void test_reverse() {
+	reverse_test( 1, XX,  3,  9);
+	reverse_test( 9, XX, -3,  1);
+	reverse_test( 1, 10,  2,  6);
+	reverse_test(XX,  4, XX, 11);
+	reverse_test( 2,  4, XX, XX);
+	reverse_test( 0, XX, 0.1, 0.3);
+	reverse_test( 1,  1, XX,  3);
+}
+
+
+void aggregate_test(float left, unsigned int count, float step, float right,
+		int flags, unsigned long skip, double sum, double min, double max) {
+	scaffolding scaffold;
+	aggregate_values aggregates;
+	unsigned long window;
+
+	setup_scaffold(&scaffold, left, count, step, right);
+	scaffold.flags |= flags;
+	scaffold.skip = skip;
+	complete_scaffold(&scaffold);
+	assert(count_window(&scaffold, &window));
+	aggregate_window(&scaffold, window, &aggregates);
+	assert(fabs(aggregates.sum - sum) < FLOAT_EQUAL_DELTA);
+	assert(fabs(aggregates.min - min) < FLOAT_EQUAL_DELTA);
+	assert(fabs(aggregates.max - max) < FLOAT_EQUAL_DELTA);
+}
+
+void exact_sum_test(double left, float step, double right, const char * expected) {
+	scaffolding scaffold;
+	aggregate_values aggregates;
+	unsigned long window;
+
+	setup_scaffold(&scaffold, 1, XX, step, 2);
+	scaffold.left = left;
+	scaffold.right = right;
+	complete_scaffold(&scaffold);
+	assert(count_window(&scaffold, &window));
+	aggregate_window(&scaffold, window, &aggregates);
+	assert(! strcmp(aggregates.exact_sum, expected));
+}
+
+void test_aggregates() {
+	scaffolding scaffold;
+	aggregate_values aggregates;
+	unsigned int i;
+
+	aggregate_test(1, XX, XX, 10, 0, 0, 55, 1, 10);
+	aggregate_test(1, XX, XX, 100000, 0, 0, 5000050000.0, 1, 100000);
+	aggregate_test(10, XX, -2, 1, 0, 2, 12, 2, 6);
+	aggregate_test(1, XX, 3, 9, FLAG_REVERSE, 1, 5, 1, 4);
+	aggregate_test(1, XX, 2, 1024, FLAG_GEOMETRIC, 0, 2047, 1, 1024);
+	aggregate_test(1, XX, 2, 1024, FLAG_GEOMETRIC | FLAG_REVERSE, 0, 2047, 1, 1024);
+	aggregate_test(1, 0, XX, 5, 0, 0, 0, 0, 0);
+
+	/* Sums of integers beyond 2^53 keep all digits */
+	exact_sum_test(1, XX, 1e10, "50000000005000000000");
+	exact_sum_test(-1e10, XX, -1, "-50000000005000000000");
+	exact_sum_test(9007199254740990.0, XX, 9007199254740992.0, "27021597764222973");
+	exact_sum_test(-9007199254740992.0, 4, 9007199254740992.0, "0");
+	exact_sum_test(-5, XX, 10, "40");
+	exact_sum_test(7, 3, 7, "7");
+	exact_sum_test(1, 0.5, 3, "");
+
+	/* Random values are drawn and stay within their range */
+	enum_random_seed(1234);
+	for (i = 0; i < 10; i++) {
+		setup_scaffold(&scaffold, 1, 50, XX, 6);
+		scaffold.flags |= FLAG_RANDOM;
+		complete_scaffold(&scaffold);
+		aggregate_window(&scaffold, 50, &aggregates);
+		assert(aggregates.min > 1 - FLOAT_EQUAL_DELTA);
+		assert(aggregates.max < 6 + FLOAT_EQUAL_DELTA);
+		assert(aggregates.min <= aggregates.max);
+		assert(aggregates.sum > 50 * aggregates.min - FLOAT_EQUAL_DELTA);
+		assert(aggregates.sum < 50 * aggregates.max + FLOAT_EQUAL_DELTA);
+	}
+}
+
+void prediction_test(float left, unsigned int count, float step, float right,
+		int flags, const char * format) {
+	scaffolding scaffold;
+	text_buffer text = {NULL, 0, 0};
+	unsigned long window;
+	unsigned long i;
+	double bytes = 0;
+
+	setup_scaffold(&scaffold, left, count, step, right);
+	scaffold.flags |= flags;
+	scaffold.format = (char *)format;
+	complete_scaffold(&scaffold);
+	assert(count_window(&scaffold, &window));
+	for (i = 0; i < window; i++) {
+		assert(multi_printf_text(format, value_at_position(&scaffold, i), &text)
+			== CUSTOM_PRINTF_SUCCESS);
+		bytes += text.length;
+	}
+	free(text.data);
+	assert(count_value_bytes(&scaffold, window) == bytes);
+}
+
+void test_prediction() {
+	/* Sign changes and magnitudes crossing 1 */
+	prediction_test(-12, XX, 0.5, 12, 0, "%.1f");
+	prediction_test(12, XX, -0.25, -3, 0, "%.2f");
+	prediction_test(-1000, XX, 7, 100000, 0, "%.0f");
+
+	/* Padding like -e|--equal-width, exponents, text around values */
+	prediction_test(-99, XX, 1, 99, 0, "%03.0f");
+	prediction_test(0.001, XX, 0.5, 2000, 0, "%e");
+	prediction_test(-5, XX, 0.001, 5, 0, "x%+.3fy");
+
+	/* Lengths not growing with magnitude */
+	prediction_test(0, XX, 0.125, 10, 0, "%g");
+	prediction_test(1, XX, 1, 1000000, 0, "%G");
+
+	/* Geometric progressions */
+	prediction_test(1, XX, 3, 1e12, FLAG_GEOMETRIC, "%.0f");
+	prediction_test(1e-9, XX, 10, 1e9, FLAG_GEOMETRIC, "%g");
+}
+
+void geometric_test(float left, unsigned int count, float ratio, float right,
+		const double * expected, unsigned long expected_count) {
+	scaffolding scaffold;
+	double dest;
+	unsigned long total;
+	unsigned long position;
+	unsigned long i;
+
+	setup_scaffold(&scaffold, left, count, ratio, right);
+	scaffold.flags |= FLAG_GEOMETRIC;
+	complete_scaffold(&scaffold);
+	assert(count_values(&scaffold, &total) && (total == expected_count));
+	for (i = 0; i < total; i++) {
+		const yield_status status = enum_yield(&scaffold, &dest);
+		assert(fabs(dest - expected[i]) < FLOAT_EQUAL_DELTA);
+		assert((status == YIELD_LAST) == (i == total - 1));
+		assert(position_of_value(&scaffold, dest, &position) && (position == i));
+	}
+}
+
+
+void test_geometric() {
+	const double doubling[] = {1, 2, 4, 8, 16, 32, 64, 128, 256, 512, 1024};
+	const double halving[] = {1024, 512, 256, 128, 64, 32, 16, 8, 4, 2, 1};
+	const double decades[] = {1, 10, 100, 1000, 10000};
+	const double tripling[] = {5, 15, 45, 135};
+	const double negative[] = {-1, -10, -100, -1000};
+	scaffolding scaffold;
+	unsigned long total;
+	double value;
+
+	geometric_test( 1,   XX,  2, 1024, doubling, 11);
+	geometric_test(XX,   XX,  2, 1024, doubling, 11);
+	geometric_test(1024, XX,  2,    1, halving,  11);
+	geometric_test(1024, XX, 0.5,   1, halving,  11);
+	geometric_test( 5,    4,  3,   XX, tripling,  4);
+	geometric_test(XX,    4,  3,  135, tripling,  4);
+	geometric_test( 5,   XX,  3,  150, tripling,  4);
+	geometric_test(-1,   XX, 10, -1000, negative,  4);
+
+	/* Logarithmically spaced */
+	geometric_test( 1,   11, XX, 1024, doubling, 11);
+	geometric_test( 1,    5, XX, 10000, decades,  5);
+
+	/* Derived ratios that are not integral need decimal places */
+	setup_scaffold(&scaffold, 1, 7, XX, 2);
+	scaffold.flags |= FLAG_GEOMETRIC;
+	complete_scaffold(&scaffold);
+	assert(scaffold.auto_precision > 0);
+
+	setup_scaffold(&scaffold, 1, 5, XX, 10000);
+	scaffold.flags |= FLAG_GEOMETRIC;
+	complete_scaffold(&scaffold);
+	assert(scaffold.auto_precision == 0);
+
+	/* Large integral ratios need none either */
+	setup_scaffold(&scaffold, 1, 3, 1e10, 1e20);
+	scaffold.flags |= FLAG_GEOMETRIC;
+	complete_scaffold(&scaffold);
+	assert(scaffold.auto_precision == 0);
+
+	setup_scaffold(&scaffold, 1, 3, XX, 1e20);
+	scaffold.flags |= FLAG_GEOMETRIC;
+	complete_scaffold(&scaffold);
+	assert(scaffold.auto_precision == 0);
+
+	/* Values overflowing to infinity end output */
+	setup_scaffold(&scaffold, 1, XX, 2, XX);
+	scaffold.flags |= FLAG_GEOMETRIC;
+	complete_scaffold(&scaffold);
+	for (total = 1; enum_yield(&scaffold, &value) == YIELD_MORE; total++) {
+		assert(total <= 1024);
+	}
+	assert((total == 1024) && (value == ldexp(1, 1023)));
+}
+
+
+void instant_test(const char * text, int expected_success, double expected) {
+	double dest;
+	const int success = parse_instant(text, &dest);
+	assert(success == expected_success);
+	assert(! success || (dest == expected));
+}
+
+
+void render_test(time_formatter * formatter, double seconds, const char * expected) {
+	time_formatter_render(formatter, seconds);
+	assert(formatter->length == strlen(expected));
+	assert(! strncmp(formatter->line, expected, formatter->length));
+}
+
+
+void test_timestamps() {
+	time_formatter formatter;
+	double dest;
+
+	instant_test("1970-01-01", 1, 0);
+	instant_test("2000-03-01T00:00:00Z", 1, 951868800);
+	instant_test("2024-02-29T12:30", 1, 1709209800);
+	instant_test("2024-02-29T14:30+02:00", 1, 1709209800);
+	instant_test("1969-12-31T23:59:59", 1, -1);
+	instant_test("2023-02-29", 0, 0);
+	instant_test("2024-01-01T24:00", 0, 0);
+	instant_test("2024-1-1", 0, 0);
+
+	assert(parse_duration("P1DT1H1M1S", &dest) && (dest == 90061));
+	assert(parse_duration("P2W", &dest) && (dest == 1209600));
+	assert(! parse_duration("P1M", &dest));
+	assert(! parse_duration("PT", &dest));
+	assert(! parse_duration("PT1H1D", &dest));
+
+	assert(time_formatter_init(&formatter, "%z") == TIME_FORMAT_INVALID);
+	assert(time_formatter_init(&formatter, "%a %e %b %Y %T, day %j, %%") == TIME_FORMAT_SUCCESS);
+	render_test(&formatter, 951782399, "Mon 28 Feb 2000 23:59:59, day 059, %");
+	render_test(&formatter, 951782400, "Tue 29 Feb 2000 00:00:00, day 060, %");
+	render_test(&formatter, 951868800, "Wed  1 Mar 2000 00:00:00, day 061, %");
+	render_test(&formatter, -86400, "Wed 31 Dec 1969 00:00:00, day 365, %");
+	time_formatter_free(&formatter);
+}
+
+
+void word_test(word_counter * counter, double value, const char * expected) {
+	double number;
+
+	word_counter_render(counter, value);
+	assert(WORD_LENGTH(counter) == strlen(expected));
+	assert(! strncmp(WORD_TEXT(counter), expected, WORD_LENGTH(counter)));
+	assert(word_to_number(counter->alphabet, expected, &number) == WORD_SUCCESS);
+	assert(number == value);
+}
+
+
+void test_alphabet() {
+	word_counter counter;
+	char * alphabet;
+	double number;
+
+	assert(expand_alphabet("a-c", &alphabet) == ALPHABET_SUCCESS);
+	assert(! strcmp(alphabet, "abc"));
+	free(alphabet);
+	assert(expand_alphabet("-0-2x", &alphabet) == ALPHABET_SUCCESS);
+	assert(! strcmp(alphabet, "-012x"));
+	free(alphabet);
+	assert(expand_alphabet("a", &alphabet) == ALPHABET_TOO_SMALL);
+	assert(expand_alphabet("a-ca", &alphabet) == ALPHABET_DUPLICATE);
+	assert(expand_alphabet("a.b", &alphabet) == ALPHABET_RESERVED);
+
+	assert(expand_alphabet("z-a", &alphabet) == ALPHABET_INVERTED);
+	assert(expand_alphabet("a-c9-0", &alphabet) == ALPHABET_INVERTED);
+
+	assert(word_to_number("abc", "abd", &number) == WORD_INVALID);
+	assert(word_to_number("abc", "", &number) == WORD_INVALID);
+
+	/* 2^53 is the last number exact in a double */
+	assert(word_to_number("01", "00000000000000000000000000000000000000000000000000000", &number)
+		== WORD_SUCCESS);
+	assert(number == 9007199254740991.0);
+	assert(word_to_number("01", "00000000000000000000000000000000000000000000000000001", &number)
+		== WORD_SUCCESS);
+	assert(number == 9007199254740992.0);
+	assert(word_to_number("01", "000000000000000000000000000000000000000000000000000000", &number)
+		== WORD_TOO_LARGE);
+	assert(word_to_number("01", "0000000000000000000000000000000000000000000000000000002", &number)
+		== WORD_INVALID);
+
+	assert(word_counter_init(&counter, "abc"));
+	word_test(&counter, 1, "a");
+	word_test(&counter, 3, "c");
+	word_test(&counter, 4, "aa");
+	word_test(&counter, 12, "cc");
+	word_test(&counter, 13, "aaa");
+	word_test(&counter, 12, "cc");
+	word_test(&counter, 11, "cb");
+	word_test(&counter, 10, "ca");
+	word_test(&counter, 9, "bc");
+	word_test(&counter, 4, "aa");
+	word_test(&counter, 3, "c");
+	word_test(&counter, 40, "aaaa");
+	word_counter_free(&counter);
+}
+
+
+int is_prime_by_division(unsigned long value) {
+	unsigned long divisor;
+
+	if (value < 2) {
+		return 0;
+	}
+	for (divisor = 2; divisor * divisor <= value; divisor++) {
+		if (value % divisor == 0) {
+			return 0;
+		}
+	}
+	return 1;
+}
+
+
+void test_primes() {
+	prime_sieve sieve;
+	unsigned long value;
+	int prime;
+
+	assert(prime_sieve_init(&sieve));
+
+	/* Around start and first segment boundary, in both directions */
+	for (value = 0; value < 1000; value++) {
+		assert((prime_sieve_check(&sieve, value, &prime) == PRIME_SUCCESS)
+			&& (prime == is_prime_by_division(value)));
+	}
+	for (value = PRIME_SEGMENT_SPAN + 1000; value > PRIME_SEGMENT_SPAN - 1000; value--) {
+		assert((prime_sieve_check(&sieve, value, &prime) == PRIME_SUCCESS)
+			&& (prime == is_prime_by_division(value)));
+	}
+
+	assert((prime_sieve_check(&sieve, 2147483647.0, &prime) == PRIME_SUCCESS) && prime);
+	assert((prime_sieve_check(&sieve, 2147483649.0, &prime) == PRIME_SUCCESS) && ! prime);
+	assert((prime_sieve_check(&sieve, 7.5, &prime) == PRIME_SUCCESS) && ! prime);
+	assert((prime_sieve_check(&sieve, -7, &prime) == PRIME_SUCCESS) && ! prime);
+	assert(prime_sieve_check(&sieve, 2 * PRIME_MAX, &prime) == PRIME_TOO_LARGE);
+	prime_sieve_free(&sieve);
+}
+
+
+void test_quasi() {
+	const double sobol[8][3] = {
+		{0, 0, 0}, {0.5, 0.5, 0.5}, {0.75, 0.25, 0.25}, {0.25, 0.75, 0.75},
+		{0.375, 0.375, 0.625}, {0.875, 0.875, 0.125}, {0.625, 0.125, 0.875},
+		{0.125, 0.625, 0.375}
+	};
+	quasi_sequence sequence;
+	quasi_sequence seeking;
+	unsigned int dimension;
+	unsigned long i;
+
+	for (dimension = 0; dimension < 3; dimension++) {
+		assert(quasi_init(&sequence, QUASI_SOBOL, dimension));
+		for (i = 0; i < 8; i++) {
+			assert(quasi_point(&sequence, i) == sobol[i][dimension]);
+		}
+	}
+
+	/* Gray code updates agree with seeking; each 64 points hit each 1/64 once */
+	for (dimension = 0; dimension < QUASI_MAX_DIMENSIONS; dimension++) {
+		double points[64];
+		int hit[64] = {0};
+
+		assert(quasi_init(&sequence, QUASI_SOBOL, dimension));
+		assert(quasi_init(&seeking, QUASI_SOBOL, dimension));
+		for (i = 0; i < 64; i++) {
+			points[i] = quasi_point(&sequence, i);
+			hit[(int)(points[i] * 64)]++;
+		}
+		for (i = 64; i > 0; i--) {
+			assert(quasi_point(&seeking, i - 1) == points[i - 1]);
+			assert(hit[i - 1] == 1);
+		}
+	}
+	assert(! quasi_init(&sequence, QUASI_SOBOL, QUASI_MAX_DIMENSIONS));
+
+	assert(quasi_init(&sequence, QUASI_HALTON, 1));
+	assert(quasi_point(&sequence, 0) == 0);
+	assert(fabs(quasi_point(&sequence, 1) - 1.0 / 3) < 1e-12);
+	assert(fabs(quasi_point(&sequence, 5) - 7.0 / 9) < 1e-12);
+	assert(quasi_init(&sequence, QUASI_VDC, 0));
+	assert(quasi_point(&sequence, 6) == 0.375);
+	assert(! quasi_init(&sequence, QUASI_VDC, 1));
+}
+
+
+void test_input() {
+	/* Tokens cross the boundaries of what a 20-byte buffer holds */
+	const char * const text = " 12.50,-3;\n1e2 0.125E1 123456789012345678 .5 4x";
+	const double values[] = {12.5, -3, 100, 1.25, 123456789012345678.0, 0.5};
+	const unsigned int precisions[] = {2, 0, 0, 2, 0, 1};
+	input_reader reader;
+	FILE * file;
+	int fds[2];
+	double value;
+	unsigned int precision;
+	unsigned int i;
+
+	assert(pipe(fds) == 0);
+	assert(write(fds[1], text, strlen(text)) == (ssize_t)strlen(text));
+	close(fds[1]);
+
+	assert(input_init(&reader, fds[0], 20));
+	for (i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+		assert(input_next_number(&reader, &value, &precision) == INPUT_NUMBER);
+		assert((value == values[i]) && (precision == precisions[i]));
+	}
+	assert(input_next_number(&reader, &value, &precision) == INPUT_INVALID);
+	assert((reader.token_length == 2) && ! strncmp(reader.token, "4x", 2));
+	assert(input_next_number(&reader, &value, &precision) == INPUT_END);
+	input_free(&reader);
+	close(fds[0]);
+
+	/* Pipes cannot be mapped, full buffers keep their content when grown */
+	assert(pipe(fds) == 0);
+	assert(write(fds[1], text, strlen(text)) == (ssize_t)strlen(text));
+	close(fds[1]);
+
+	assert(input_init(&reader, fds[0], 8));
+	assert(! input_map(&reader) && ! reader.mapped);
+	while (reader.end < reader.capacity) {
+		assert(input_refill(&reader) > 0);
+	}
+	assert(input_grow(&reader) && (reader.capacity == 16));
+	while (! reader.eof) {
+		if (reader.end == reader.capacity) {
+			assert(input_grow(&reader));
+		}
+		assert(input_refill(&reader) >= 0);
+	}
+	assert((reader.end == strlen(text)) && ! memcmp(reader.data, text, reader.end));
+	input_free(&reader);
+	close(fds[0]);
+
+	/* Mapped files start where the file descriptor is at */
+	file = tmpfile();
+	assert(file);
+	assert(fputs(text, file) >= 0);
+	assert(fflush(file) == 0);
+	assert(lseek(fileno(file), 11, SEEK_SET) == 11);
+	assert(input_init(&reader, fileno(file), 20));
+	if (input_map(&reader)) {
+		assert(reader.end - reader.start == strlen(text) - 11);
+		assert(! memcmp(reader.data + reader.start, text + 11, strlen(text) - 11));
+	}
+	input_free(&reader);
+	fclose(file);
+}
+
+
+void test_shard() {
+	shard_test( 2, XX, XX, 11, 0);
+	shard_test( 2, XX, XX, 11, 3);
+	shard_test( 2, XX, XX, 11, 20);
+	shard_test( 1, 10,  2,  6, 0);
+	shard_test(XX,  4,  3, XX, 1);
+	shard_test( 1, XX, XX,  1, 0);
+}
+
+void test_chacha20() {
+	/* Test vector from RFC 7539, section 2.3.2 */
+	const unsigned int expected[CHACHA20_BLOCK_WORDS] = {
+		0xe4e7f110U, 0x15593bd1U, 0x1fdd0f50U, 0xc47120a3U,
+		0xc7f4d1c7U, 0x0368c033U, 0x9aaa2204U, 0x4e6cd4c3U,
+		0x466482d2U, 0x09aa9f07U, 0x05d7c214U, 0xa2028bd9U,
+		0xd19c12b5U, 0xb94e16deU, 0xe883d0cbU, 0x4e3c50a2U
+	};
+	const unsigned char nonce[4 * CHACHA20_NONCE_WORDS] = {
+		0x00, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x4a, 0x00, 0x00, 0x00, 0x00
+	};
+	unsigned char key[4 * CHACHA20_KEY_WORDS];
+	unsigned int dest[2 * CHACHA20_BLOCK_WORDS];
+	chacha20_context context;
+	unsigned int i;
+
+	for (i = 0; i < sizeof(key); i++) {
+		key[i] = i;
+	}
+
+	chacha20_init(&context, key, nonce, 1);
+	chacha20_keystream(&context, dest, 2);
+	for (i = 0; i < CHACHA20_BLOCK_WORDS; i++) {
+		assert(dest[i] == expected[i]);
+	}
+
+	/* Producing blocks one by one must not make a difference */
+	chacha20_init(&context, key, nonce, 2);
+	chacha20_keystream(&context, dest, 1);
+	for (i = 0; i < CHACHA20_BLOCK_WORDS; i++) {
+		assert(dest[i] == dest[CHACHA20_BLOCK_WORDS + i]);
+	}
+}
+
+void ordering_test(tuple_order order, unsigned long rows, unsigned long columns,
+		unsigned long tile_size) {
+	const unsigned long counts[2] = {rows, columns};
+	int seen[16 * 16] = {0};
+	unsigned long previous[2];
+	unsigned long total = 0;
+	tuple_walk walk;
+	tuple_walk_status status;
+
+	assert(rows * columns <= 16 * 16);
+	status = tuple_walk_init(&walk, order, 2, counts, tile_size);
+	assert(status == TUPLE_WALK_SUCCESS);
+	do {
+		const unsigned long row = walk.positions[0];
+		const unsigned long column = walk.positions[1];
+
+		assert((row < rows) && (column < columns));
+		assert(! seen[row * columns + column]);
+		seen[row * columns + column] = 1;
+
+		/* Hilbert curves only take single steps on square grids */
+		if ((order == ORDER_HILBERT) && (rows == columns) && ((rows & (rows - 1)) == 0)
+				&& (total > 0)) {
+			assert(((row > previous[0]) ? row - previous[0] : previous[0] - row)
+				+ ((column > previous[1]) ? column - previous[1] : previous[1] - column) == 1);
+		}
+		previous[0] = row;
+		previous[1] = column;
+		total++;
+	} while (tuple_walk_next(&walk));
+	tuple_walk_free(&walk);
+
+	assert(total == rows * columns);
+}
+
+void test_ordering() {
+	const unsigned long counts[2] = {2, 100000};
+	unsigned long total = 1;
+	tuple_walk walk;
+
+	ordering_test(ORDER_ROW,     5, 3, 0);
+	ordering_test(ORDER_MORTON,  5, 3, 0);
+	ordering_test(ORDER_MORTON,  1, 9, 0);
+	ordering_test(ORDER_HILBERT, 5, 3, 0);
+	ordering_test(ORDER_HILBERT, 8, 8, 0);
+	ordering_test(ORDER_HILBERT, 16, 16, 0);
+	ordering_test(ORDER_HILBERT, 1, 9, 0);
+	ordering_test(ORDER_HILBERT, 2, 100, 0);
+	ordering_test(ORDER_HILBERT, 13, 3, 0);
+
+	/* Ranges of very different sizes, most Hilbert codes are outside */
+	assert(tuple_walk_init(&walk, ORDER_HILBERT, 2, counts, 0) == TUPLE_WALK_SUCCESS);
+	while (tuple_walk_next(&walk)) {
+		total++;
+	}
+	tuple_walk_free(&walk);
+	assert(total == 2 * 100000);
+	ordering_test(ORDER_TILED,   5, 3, 2);
+	ordering_test(ORDER_TILED,   7, 9, 16);
+}
+
+void ranges_setup(scaffolding * dest, unsigned int dimension_count, const float * bounds) {
+	unsigned int i;
+
+	initialize_scaffold(dest);
+	dest->dimensions = (scaffolding *)malloc(dimension_count * sizeof(scaffolding));
+	assert(dest->dimensions);
+	dest->dimension_count = dimension_count;
+	for (i = 0; i < dimension_count; i++) {
+		setup_scaffold(dest->dimensions + i, bounds[4 * i], (unsigned int)bounds[4 * i + 1],
+			bounds[4 * i + 2], bounds[4 * i + 3]);
+	}
+}
+
+void ranges_release(scaffolding * dest) {
+	unsigned int i;
+
+	for (i = 0; i < dest->dimension_count; i++) {
+		free(dest->dimensions[i].format);
+	}
+	free(dest->dimensions);
+	free(dest->format);
+}
+
+ranges_status ranges_test(unsigned int dimension_count, const float * bounds,
+		int flags, int range_flags, set_operation operation, tuple_order order) {
+	scaffolding dest;
+	ranges_status status;
+
+	ranges_setup(&dest, dimension_count, bounds);
+	dest.flags |= flags;
+	dest.dimensions[dimension_count - 1].flags |= range_flags;
+	dest.operation = operation;
+	dest.order = order;
+	status = complete_ranges(&dest);
+	ranges_release(&dest);
+	return status;
+}
+
+void product_test(unsigned int dimension_count, const float * bounds, tuple_order order,
+		long limit, const double * expected, unsigned long expected_count) {
+	scaffolding dest;
+	range_product product;
+	unsigned long total = 0;
+	unsigned int i;
+
+	ranges_setup(&dest, dimension_count, bounds);
+	dest.order = order;
+	if (limit >= 0) {
+		dest.limit = (unsigned long)limit;
+		dest.flags |= FLAG_LIMIT_SET;
+	}
+	assert(complete_ranges(&dest) == RANGES_SUCCESS);
+	assert(range_product_init(&product, &dest) == RANGES_SUCCESS);
+	assert(product.finite);
+	if (! product.done) {
+		do {
+			assert(total < expected_count);
+			for (i = 0; i < dimension_count; i++) {
+				assert(range_product_value(&product, i)
+					== expected[total * dimension_count + i]);
+			}
+			total++;
+		} while (range_product_next(&product));
+	}
+	assert(! range_product_next(&product));
+	range_product_free(&product);
+	ranges_release(&dest);
+
+	assert(total == expected_count);
+}
+
+void test_ranges() {
+	const float two_by_three[] = {1, XX, XX, 2, 5, 3, XX, 15};
+	const float empty[] = {1, XX, XX, 2, 1, 0, XX, XX};
+	const float first_infinite[] = {1, XX, XX, XX, 1, XX, XX, 2};
+	const float inner_infinite[] = {1, XX, XX, 2, 1, XX, XX, XX};
+	const float fractions[] = {1, XX, XX, 2, 0, XX, 0.5, 2};
+	const float descending[] = {1, XX, XX, 2, 10, XX, -1, XX};
+	const float huge[] = {1, XX, XX, 1e12, 1, XX, XX, 1e12};
+	const double rows[] = {1, 5, 1, 10, 1, 15, 2, 5, 2, 10, 2, 15};
+	const double morton[] = {1, 5, 2, 5, 1, 10, 2, 10, 1, 15, 2, 15};
+	const double limited[] = {1, 1, 1, 2, 2, 1, 2, 2, 3, 1};
+	scaffolding dest;
+	range_product product;
+
+	/* Odometer, last range advancing fastest, and other orders */
+	product_test(2, two_by_three, ORDER_ROW, -1, rows, 6);
+	product_test(2, two_by_three, ORDER_ROW, 4, rows, 4);
+	product_test(2, two_by_three, ORDER_ROW, 0, rows, 0);
+	product_test(2, two_by_three, ORDER_MORTON, -1, morton, 6);
+	product_test(2, empty, ORDER_ROW, -1, rows, 0);
+	product_test(2, first_infinite, ORDER_ROW, 5, limited, 5);
+
+	/* Infinite first range without limit */
+	ranges_setup(&dest, 2, first_infinite);
+	assert(complete_ranges(&dest) == RANGES_SUCCESS);
+	assert(range_product_init(&product, &dest) == RANGES_SUCCESS);
+	assert(! product.finite && ! product.done);
+	range_product_free(&product);
+	ranges_release(&dest);
+
+	/* Codes of tuples not fitting into an unsigned long */
+	ranges_setup(&dest, 2, huge);
+	dest.order = ORDER_HILBERT;
+	assert(complete_ranges(&dest) == RANGES_SUCCESS);
+	assert(range_product_init(&product, &dest) == RANGES_TOO_LARGE);
+	range_product_free(&product);
+	ranges_release(&dest);
+
+	/* Rejected combinations */
+	assert(ranges_test(2, two_by_three, 0, 0, SET_NONE, ORDER_ROW) == RANGES_SUCCESS);
+	assert(ranges_test(2, two_by_three, FLAG_RANDOM, 0, SET_NONE, ORDER_ROW)
+		== RANGES_SINGLE_RANGE_OPTION);
+	assert(ranges_test(2, two_by_three, FLAG_REVERSE, 0, SET_NONE, ORDER_ROW)
+		== RANGES_SINGLE_RANGE_OPTION);
+	assert(ranges_test(2, two_by_three, FLAG_CONCAT | FLAG_ZIP, 0, SET_NONE, ORDER_ROW)
+		== RANGES_CONCAT_OPTION);
+	assert(ranges_test(2, two_by_three, FLAG_CONCAT, 0, SET_NONE, ORDER_TILED)
+		== RANGES_CONCAT_OPTION);
+	assert(ranges_test(2, two_by_three, FLAG_ZIP, 0, SET_UNION, ORDER_ROW)
+		== RANGES_SET_OPTION);
+	assert(ranges_test(2, two_by_three, FLAG_GEOMETRIC, 0, SET_NONE, ORDER_ROW)
+		== RANGES_SEQUENCE_OPTION);
+	assert(ranges_test(2, two_by_three, FLAG_PRIMES, 0, SET_NONE, ORDER_ROW)
+		== RANGES_SEQUENCE_OPTION);
+	assert(ranges_test(2, two_by_three, FLAG_ZIP, 0, SET_NONE, ORDER_MORTON)
+		== RANGES_ZIP_ORDER);
+	assert(ranges_test(2, two_by_three, 0, FLAG_EXCEPT, SET_NONE, ORDER_ROW)
+		== RANGES_EXCEPT_WITHOUT_SET);
+	assert(ranges_test(2, two_by_three, 0, FLAG_RANDOM, SET_INTERSECTION, ORDER_ROW)
+		== RANGES_SET_RANDOM);
+	assert(ranges_test(2, two_by_three, 0, FLAG_RANDOM, SET_NONE, ORDER_ROW)
+		== RANGES_RANDOM_WITHOUT_ZIP);
+	assert(ranges_test(2, inner_infinite, 0, 0, SET_NONE, ORDER_ROW)
+		== RANGES_INNER_INFINITY);
+	assert(ranges_test(2, descending, 0, 0, SET_UNION, ORDER_ROW)
+		== RANGES_SET_DESCENDING_INFINITY);
+	assert(ranges_test(2, fractions, 0, 0, SET_UNION, ORDER_ROW)
+		== RANGES_SET_NOT_INTEGERS);
+	assert(ranges_test(2, first_infinite, FLAG_CONCAT, 0, SET_NONE, ORDER_ROW)
+		== RANGES_CONCAT_INFINITY);
+	assert(ranges_test(2, first_infinite, 0, 0, SET_NONE, ORDER_HILBERT)
+		== RANGES_ORDER_INFINITY);
+
+	ranges_setup(&dest, 2, first_infinite);
+	dest.dimensions[0].flags |= FLAG_EQUAL_WIDTH;
+	assert(complete_ranges(&dest) == RANGES_EQUAL_WIDTH_INFINITY);
+	ranges_release(&dest);
+
+	ranges_setup(&dest, 2, two_by_three);
+	dest.field_format_count = 3;
+	assert(complete_ranges(&dest) == RANGES_TOO_MANY_FORMATS);
+	ranges_release(&dest);
+}
+
+unsigned long zip_test(unsigned int dimension_count, const float * bounds, long limit,
+		unsigned int random_index, const double * expected) {
+	scaffolding dest;
+	range_zip zip;
+	double values[3];
+	unsigned long total = 0;
+	unsigned int i;
+
+	assert(dimension_count <= 3);
+	ranges_setup(&dest, dimension_count, bounds);
+	dest.flags |= FLAG_ZIP;
+	if (limit >= 0) {
+		dest.limit = (unsigned long)limit;
+		dest.flags |= FLAG_LIMIT_SET;
+	}
+	if (random_index < dimension_count) {
+		dest.dimensions[random_index].flags |= FLAG_RANDOM;
+	}
+	assert(complete_ranges(&dest) == RANGES_SUCCESS);
+	range_zip_init(&zip, &dest);
+	assert(zip.finite);
+	assert(zip.random == (random_index < dimension_count));
+
+	while (range_zip_next(&zip, values)) {
+		for (i = 0; i < dimension_count; i++) {
+			if (i == random_index) {
+				scaffolding const * const range = dest.dimensions + i;
+				assert((values[i] >= range->left - FLOAT_EQUAL_DELTA)
+					&& (values[i] <= range->right + FLOAT_EQUAL_DELTA));
+			} else {
+				assert(values[i] == expected[total * dimension_count + i]);
+			}
+		}
+		total++;
+	}
+	assert(! range_zip_next(&zip, values));
+	ranges_release(&dest);
+
+	return total;
+}
+
+void test_zip() {
+	const float short_long[] = {1, XX, XX, 3, 10, XX, 10, 50};
+	const float long_short[] = {10, XX, 10, 50, 1, XX, XX, 3};
+	const float empty[] = {1, XX, XX, 3, 1, 0, XX, XX};
+	const float infinite[] = {1, XX, XX, XX, 5, XX, -1, 1};
+	const float random[] = {1, XX, XX, 2, 1, XX, XX, 7, 0, XX, XX, XX};
+	const float random_count[] = {1, 2, XX, 2, 1, XX, XX, 7};
+	const double rows[] = {1, 10, 2, 20, 3, 30};
+	const double swapped[] = {10, 1, 20, 2, 30, 3};
+	const double countdown[] = {1, 5, 2, 4, 3, 3, 4, 2, 5, 1};
+	const double random_rows[] = {0, 1, 0, 0, 2, 1, 0, 3, 2, 0, 4, 3, 0, 5, 4, 0, 6, 5, 0, 7, 6};
+	const double random_pairs[] = {0, 1, 0, 2};
+	scaffolding dest;
+
+	/* Stop at the shortest range, whichever it is */
+	assert(zip_test(2, short_long, -1, XX, rows) == 3);
+	assert(zip_test(2, long_short, -1, XX, swapped) == 3);
+	assert(zip_test(2, empty, -1, XX, rows) == 0);
+	assert(zip_test(2, infinite, -1, XX, countdown) == 5);
+
+	/* Stop at --limit=COUNT */
+	assert(zip_test(2, short_long, 2, XX, rows) == 2);
+	assert(zip_test(2, short_long, 0, XX, rows) == 0);
+	assert(zip_test(2, infinite, 3, XX, countdown) == 3);
+
+	/* Random ranges draw as many values as other ranges need */
+	enum_random_seed(1234);
+	assert(zip_test(3, random, -1, 0, random_rows) == 7);
+	assert(zip_test(2, random_count, -1, 0, random_pairs) == 2);
+	assert(zip_test(2, short_long, -1, 1, rows) == 3);
+
+	ranges_setup(&dest, 3, random);
+	dest.flags |= FLAG_ZIP;
+	dest.dimensions[0].flags |= FLAG_RANDOM;
+	assert(complete_ranges(&dest) == RANGES_SUCCESS);
+	assert(HAS_COUNT(dest.dimensions) && (dest.dimensions[0].count == ULONG_MAX));
+	assert(dest.dimensions[1].count == 7);
+	ranges_release(&dest);
+
+	ranges_setup(&dest, 2, random_count);
+	dest.flags |= FLAG_ZIP;
+	dest.dimensions[0].flags |= FLAG_RANDOM;
+	assert(complete_ranges(&dest) == RANGES_SUCCESS);
+	assert(dest.dimensions[0].count == 2);
+	ranges_release(&dest);
+}
+
+void split_test(int argc, char ** argv, int attached, int expected_argc,
+		const char * const * expected) {
+	int split_argc;
+	char ** split_argv;
+	int i;
+
+	assert(split_at_commas(argc, argv, attached, &split_argc, &split_argv));
+	assert(split_argc == expected_argc);
+	for (i = 0; i < split_argc; i++) {
+		assert(! strcmp(split_argv[i], expected[i]));
+		free(split_argv[i]);
+	}
+	free(split_argv);
+}
+
+void concat_test(unsigned int dimension_count, const float * bounds, long limit,
+		const double * expected, unsigned long expected_count) {
+	scaffolding dest;
+	range_concat concat;
+	unsigned long total = 0;
+	double value;
+	unsigned int index;
+	unsigned int last_index = 0;
+
+	ranges_setup(&dest, dimension_count, bounds);
+	dest.flags |= FLAG_CONCAT;
+	if (limit >= 0) {
+		dest.limit = (unsigned long)limit;
+		dest.flags |= FLAG_LIMIT_SET;
+	}
+	assert(complete_ranges(&dest) == RANGES_SUCCESS);
+	range_concat_init(&concat, &dest);
+	assert(concat.finite);
+
+	while (range_concat_next(&concat, &value, &index)) {
+		assert(total < expected_count);
+		assert(value == expected[total]);
+		assert((index >= last_index) && (index < dimension_count));
+		last_index = index;
+		total++;
+	}
+	assert(! range_concat_next(&concat, &value, &index));
+	ranges_release(&dest);
+
+	assert(total == expected_count);
+}
+
+void shared_format_test(unsigned int dimension_count, const float * bounds, int flags,
+		unsigned int precision, double value, const char * expected) {
+	scaffolding dest;
+	text_buffer text = {NULL, 0, 0};
+	unsigned int i;
+
+	ranges_setup(&dest, dimension_count, bounds);
+	dest.flags |= FLAG_CONCAT | flags;
+	for (i = 0; i < dimension_count; i++) {
+		dest.dimensions[i].flags |= flags;
+	}
+	/* As parsed from the step of the first range */
+	dest.dimensions[0].auto_precision = precision;
+	assert(complete_ranges(&dest) == RANGES_SUCCESS);
+	for (i = 0; i < dimension_count; i++) {
+		assert(! strcmp(dest.dimensions[i].format, dest.dimensions[0].format));
+	}
+	assert(multi_printf_text(dest.dimensions[dimension_count - 1].format, value, &text)
+		== CUSTOM_PRINTF_SUCCESS);
+	assert((text.length == strlen(expected)) && ! strncmp(text.data, expected, text.length));
+	free(text.data);
+	ranges_release(&dest);
+}
+
+void test_concat() {
+	char attached[] = "1..3,5";
+	char loose[] = "7";
+	char leading[] = ",1";
+	char trailing[] = "2,";
+	char comma[] = ",";
+	char doubled[] = "1,,-2";
+	char range[] = "1..3x0.5..10";
+	char * attached_argv[] = {attached, loose};
+	char * edges_argv[] = {leading, trailing, comma};
+	char * doubled_argv[] = {doubled};
+	char * range_argv[] = {range};
+	const char * const attached_split[] = {"1..3", ",", "5", "7"};
+	const char * const edges_split[] = {",", "1", "2", ",", ","};
+	const char * const doubled_split[] = {"1", ",", ",", "-2"};
+	const char * const range_split[] = {"1..3x0.5..10"};
+	const char * const edges_argv_copy[] = {",1", "2,", ","};
+	const char * const doubled_copy[] = {"1,,-2"};
+	const float two[] = {1, XX, XX, 3, 10, XX, 2, 14};
+	const float gaps[] = {1, XX, XX, 3, 5, 0, XX, XX, 10, XX, XX, XX};
+	const float fractions[] = {1, XX, 0.5, 2, 10, XX, XX, 12};
+	const float widths[] = {1, XX, XX, 2, 5, XX, XX, 100};
+	const double values[] = {1, 2, 3, 10, 12, 14};
+	const double gap_values[] = {1, 2, 3, 10, 11, 12, 13};
+
+	/* Commas attached to ranges become arguments of their own */
+	split_test(2, attached_argv, 1, 4, attached_split);
+	split_test(3, edges_argv, 1, 5, edges_split);
+	split_test(1, doubled_argv, 1, 4, doubled_split);
+	split_test(1, range_argv, 1, 1, range_split);
+
+	/* Without --concat, only commas of their own separate ranges */
+	split_test(3, edges_argv, 0, 3, edges_argv_copy);
+	split_test(1, doubled_argv, 0, 1, doubled_copy);
+
+	/* --limit=COUNT spans several ranges */
+	concat_test(2, two, -1, values, 6);
+	concat_test(2, two, 2, values, 2);
+	concat_test(2, two, 4, values, 4);
+	concat_test(2, two, 0, values, 0);
+	concat_test(3, gaps, 5, gap_values, 5);
+	concat_test(3, gaps, 7, gap_values, 7);
+
+	/* Default format of the largest precision and widest bounds */
+	shared_format_test(2, fractions, 0, 1, 11, "11.0");
+	shared_format_test(2, widths, FLAG_EQUAL_WIDTH, 0, 7, "007");
+	shared_format_test(2, widths, FLAG_EQUAL_WIDTH, 2, 7, "007.00");
+	shared_format_test(2, two, 0, 0, 10, "10");
+}
+
+void progression_test(set_operation operation, const progression * included,
+		unsigned int included_count, const progression * excluded,
+		unsigned int excluded_count) {
+	progression_merge merge;
+	progression_status status;
+	double value;
+	double candidate;
+
+	status = progression_merge_init(&merge, operation,
+		included, included_count, excluded, excluded_count);
+	assert(status == PROGRESSION_SUCCESS);
+
+	/* Compare against filtering all candidates */
+	for (candidate = -100; candidate <= 100; candidate++) {
+		int wanted = (operation == SET_INTERSECTION);
+		unsigned int i;
+
+		for (i = 0; i < included_count; i++) {
+			if (operation == SET_UNION) {
+				wanted = wanted || progression_contains(included + i, candidate);
+			} else {
+				wanted = wanted && progression_contains(included + i, candidate);
+			}
+		}
+		for (i = 0; i < excluded_count; i++) {
+			wanted = wanted && ! progression_contains(excluded + i, candidate);
+		}
+
+		if (wanted) {
+			const int more = progression_merge_next(&merge, &value);
+			assert(more);
+			assert(value == candidate);
+		}
+	}
+	assert(! progression_merge_next(&merge, &value));
+	progression_merge_free(&merge);
+}
+
+void progression_values_test(set_operation operation, const progression * included,
+		unsigned int included_count, const double * expected, unsigned int expected_count) {
+	progression_merge merge;
+	double value;
+	unsigned int i;
+
+	assert(progression_merge_init(&merge, operation, included, included_count, NULL, 0)
+		== PROGRESSION_SUCCESS);
+	for (i = 0; i < expected_count; i++) {
+		assert(progression_merge_next(&merge, &value));
+		assert(value == expected[i]);
+	}
+	assert(! progression_merge_next(&merge, &value));
+	progression_merge_free(&merge);
+}
+
+void test_progression() {
+	const progression threes_fives[2] = {{3, 3, 99, 0}, {5, 5, 100, 0}};
+	const progression fifteens[1] = {{15, 15, 90, 0}};
+	const progression odd_residues[3] = {{-99, 4, 97, 0}, {-98, 6, 100, 0}, {-100, 5, 95, 0}};
+	const progression disjoint[2] = {{0, 2, 100, 0}, {1, 4, 97, 0}};
+	const progression overlapping[2] = {{-10, 1, 10, 0}, {0, 1, 20, 0}};
+	const progression huge[2] = {{0, 9007199254740881.0, 0, 1}, {0, 9007199254740847.0, 0, 1}};
+	const progression finite_top[2] = {{9007199254740990.0, 1, 9007199254740992.0, 0}, {1, 1, 2, 0}};
+	const progression infinite_top[2] = {{9007199254740991.0, 1, 0, 1}, {1, 1, 2, 0}};
+	const progression odd_top[1] = {{9007199254740989.0, 2, 0, 1}};
+	const progression everything[2] = {{0, 1, 0, 1}, {9007199254740990.0, 1, 0, 1}};
+	const double finite_top_values[] = {1, 2, 9007199254740990.0, 9007199254740991.0,
+		9007199254740992.0};
+	const double infinite_top_values[] = {1, 2, 9007199254740991.0, 9007199254740992.0};
+	const double odd_top_values[] = {9007199254740989.0, 9007199254740991.0};
+	progression intersection;
+
+	progression_test(SET_UNION, threes_fives, 2, fifteens, 1);
+	progression_test(SET_UNION, odd_residues, 3, NULL, 0);
+	progression_test(SET_UNION, overlapping, 2, NULL, 0);
+	progression_test(SET_INTERSECTION, threes_fives, 2, NULL, 0);
+	progression_test(SET_INTERSECTION, odd_residues, 3, NULL, 0);
+	progression_test(SET_INTERSECTION, disjoint, 2, NULL, 0);
+	progression_test(SET_INTERSECTION, overlapping, 2, threes_fives, 2);
+
+	/* Steps of coprime large primes have no exact common multiple */
+	assert(progression_intersect(huge, huge + 1, &intersection) == PROGRESSION_TOO_LARGE);
+
+	/* Ranges ending at 2^53, where adding a step would round */
+	progression_values_test(SET_UNION, finite_top, 2, finite_top_values, 5);
+	progression_values_test(SET_UNION, infinite_top, 2, infinite_top_values, 4);
+	progression_values_test(SET_UNION, odd_top, 1, odd_top_values, 2);
+	progression_values_test(SET_INTERSECTION, finite_top, 1, finite_top_values + 2, 3);
+	progression_values_test(SET_INTERSECTION, everything, 2, finite_top_values + 2, 3);
+}
+
+void blake3_test(unsigned int length, const char * expected_hex) {
+	unsigned char input[2048];
+	unsigned char digest[BLAKE3_OUT_LEN];
+	char hex[2 * BLAKE3_OUT_LEN + 1];
+	blake3_context context;
+	unsigned int i;
+
+	assert(length <= sizeof(input));
+	for (i = 0; i < length; i++) {
+		input[i] = i % 251;
+	}
+
+	/* Feeding odd pieces must not make a difference */
+	blake3_init(&context);
+	for (i = 0; i < length; i += 7) {
+		blake3_update(&context, input + i, ENUM_MIN(7, length - i));
+	}
+	blake3_final(&context, digest);
+
+	for (i = 0; i < BLAKE3_OUT_LEN; i++) {
+		sprintf(hex + 2 * i, "%02x", digest[i]);
+	}
+	assert(! strcmp(hex, expected_hex));
+}
+
+void test_blake3() {
+	/* Test vectors from the BLAKE3 reference implementation */
+	blake3_test(   0, "af1349b9f5f9a1a6a0404dea36dcc9499bcb25c9adc112b7cc9a93cae41f3262");
+	blake3_test(   1, "2d3adedff11b61f14c886e35afa036736dcd87a74d27b5c1510225d0f592e213");
+	blake3_test(  64, "4eed7141ea4a5cd4b788606bd23f46e212af9cacebacdc7d1f4c6dc7f2511b98");
+	blake3_test(1023, "10108970eeda3eb932baac1428c7a2163b0e924c9a9e25b35bba72b28f70bd11");
+	blake3_test(1024, "42214739f095a406f3fc83deb889744ac00df831c10daa55189b5d121c855af7");
+	blake3_test(1025, "d00278ae47eb27b34faecf67b4fe263f82d5412916c1ffd97c8cb7fb814b8444");
+	blake3_test(2048, "e776b6028c7cd22a4d0ba182a8bf62205d2ef576467e838ed6f2529b85fba24a");
+}
+
 int main() {
 	unsigned int successes = 0;
 	unsigned int failures = 0;
@@ -308,6 +1685,34 @@ int main() {
 	);
 	
 	test_unescape();
+
+	test_distributions();
+	test_random_text();
+	test_alias_table();
+	test_walk();
+
+	test_window();
+
+	test_shard();
+
+	test_reverse();
+
+	test_geometric();
+	test_aggregates();
+	test_prediction();
+	test_timestamps();
+	test_alphabet();
+	test_primes();
+	test_quasi();
+	test_input();
+
+	test_chacha20();
+	test_blake3();
+	test_ordering();
+	test_ranges();
+	test_zip();
+	test_concat();
+	test_progression();
 	
 	return failures;
 }